@@ -11,9 +11,317 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <string>
+#include <vector>
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <utility>
+#include <random>
+#include <cstring>
+#include <cctype>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string_view>
+#include <charconv>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdint>
+#include <climits>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EMPLOYEE_HAVE_AVX2_KERNELS 1
+#endif
 using namespace std;
 
-// max num of each employee type
+/* 
+* Class: Hours
+* Purpose: An exact number of hours stored as a whole number of hundredths of an hour.
+           Hours read in are rounded to the nearest hundredth (halves away from zero)
+*/
+class Hours {
+private:
+    // the number of hundredths of an hour
+    long long hundredths;
+
+public:
+    // number of hundredths in one hour
+    static const long long HUNDREDTHS_PER_HOUR = 100;
+
+    /* 
+    * Purpose: To construct/initialize zero Hours
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    constexpr Hours() : hundredths(0) {}
+
+    // factory methods for Hours in whole hours and hundredths of an hour
+    static constexpr Hours fromHundredths(long long hundredths) {return Hours(hundredths);}
+    static constexpr Hours fromWhole(long long hours) {return Hours(hours * HUNDREDTHS_PER_HOUR);}
+
+    /* 
+    * Purpose: To read Hours from the decimal text of a number such as "45" or "31.79". Reading stops at the
+    *          first character that is not part of the number, like the >> operator does for a double
+    * Parameters: text - the text to read
+    * Returns: the Hours in the text rounded to the nearest hundredth, 0 if the text does not start with a number
+    * Side Effects: NONE
+    */
+    static Hours parse(string_view text);
+
+    // get methods
+    constexpr long long getHundredths() const {return hundredths;}
+
+    // comparison and arithmetic operators
+    constexpr bool operator<(const Hours &other) const {return hundredths < other.hundredths;}
+    constexpr bool operator>(const Hours &other) const {return hundredths > other.hundredths;}
+    constexpr bool operator<=(const Hours &other) const {return hundredths <= other.hundredths;}
+    constexpr bool operator>=(const Hours &other) const {return hundredths >= other.hundredths;}
+    constexpr bool operator==(const Hours &other) const {return hundredths == other.hundredths;}
+    constexpr bool operator!=(const Hours &other) const {return hundredths != other.hundredths;}
+    constexpr Hours operator-(const Hours &other) const {return Hours(hundredths - other.hundredths);}
+
+    /* 
+    * Purpose: To print Hours with two decimal places
+    * Parameters: out - the stream to print to
+    *             hours - the Hours to print
+    * Returns: out so prints can be chained
+    * Side Effects: the hours are written to out
+    */
+    friend ostream &operator<<(ostream &out, const Hours &hours);
+
+private:
+    // constructor used by the factory methods
+    explicit constexpr Hours(long long hundredths) : hundredths(hundredths) {}
+}; // Class Hours
+
+/* 
+* Class: Money
+* Purpose: An exact amount of money stored as a whole number of millionths of a dollar (micros).
+           All pay calculations are done with Money so they are exact and give the same totals in
+           any order. The rounding rules are:
+             - pay rates and sales are rounded to the nearest cent when they are set
+             - hours are rounded to the nearest hundredth of an hour when they are read
+             - overtime multipliers are whole percents and commission rates are whole basis points,
+               so with the two rules above normal pay, overtime and commission never need rounding
+             - amounts are rounded to the nearest cent when printed
+           Every rounding rounds halves away from zero
+*/
+class Money {
+private:
+    // the amount in millionths of a dollar
+    long long micros;
+
+public:
+    // number of micros in a cent and in a dollar
+    static const long long MICROS_PER_CENT = 10000;
+    static const long long MICROS_PER_DOLLAR = 100 * MICROS_PER_CENT;
+
+    /* 
+    * Purpose: To construct/initialize $0
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    constexpr Money() : micros(0) {}
+
+    // factory methods for Money in micros, cents and whole dollars
+    static constexpr Money fromMicros(long long micros) {return Money(micros);}
+    static constexpr Money fromCents(long long cents) {return Money(cents * MICROS_PER_CENT);}
+    static constexpr Money fromDollars(long long dollars) {return Money(dollars * MICROS_PER_DOLLAR);}
+
+    /* 
+    * Purpose: To read Money from the decimal text of a number such as "14" or "100.1". Reading stops at the
+    *          first character that is not part of the number, like the >> operator does for a double
+    * Parameters: text - the text to read
+    * Returns: the Money in the text rounded to the nearest micro, $0 if the text does not start with a number
+    * Side Effects: NONE
+    */
+    static Money parse(string_view text);
+
+    /* 
+    * Purpose: To divide a whole number and round the result to the nearest whole number, halves away from zero
+    * Parameters: value - the number to divide
+    *             divisor - the number to divide by, must be greater than 0
+    * Returns: the rounded result
+    * Side Effects: NONE
+    */
+    static constexpr long long divideRounded(__int128 value, long long divisor) {
+        return (long long)(value >= 0 ? (value + divisor / 2) / divisor : -((-value + divisor / 2) / divisor));
+    }
+
+    // get methods
+    constexpr long long getMicros() const {return micros;}
+    constexpr long long getCents() const {return divideRounded(micros, MICROS_PER_CENT);}
+
+    // the amount rounded to the nearest cent
+    constexpr Money roundedToCents() const {return fromCents(getCents());}
+
+    // the pay for working a number of hours at this hourly rate
+    constexpr Money times(const Hours &hours) const {
+        return Money(divideRounded((__int128)micros * hours.getHundredths(), Hours::HUNDREDTHS_PER_HOUR));
+    }
+    // the amount multiplied by a whole percent (150 is one and a half times)
+    constexpr Money timesPercent(long long percent) const {return Money(divideRounded((__int128)micros * percent, 100));}
+    // the amount multiplied by a whole number of basis points (200 is 2%)
+    constexpr Money timesBasisPoints(long long basisPoints) const {return Money(divideRounded((__int128)micros * basisPoints, 10000));}
+
+    // comparison and arithmetic operators
+    constexpr bool operator<(const Money &other) const {return micros < other.micros;}
+    constexpr bool operator>(const Money &other) const {return micros > other.micros;}
+    constexpr bool operator<=(const Money &other) const {return micros <= other.micros;}
+    constexpr bool operator>=(const Money &other) const {return micros >= other.micros;}
+    constexpr bool operator==(const Money &other) const {return micros == other.micros;}
+    constexpr bool operator!=(const Money &other) const {return micros != other.micros;}
+    constexpr Money operator+(const Money &other) const {return Money(micros + other.micros);}
+    constexpr Money operator-(const Money &other) const {return Money(micros - other.micros);}
+    Money &operator+=(const Money &other) {micros += other.micros; return *this;}
+    Money &operator-=(const Money &other) {micros -= other.micros; return *this;}
+
+    /* 
+    * Purpose: To print Money rounded to the nearest cent with two decimal places
+    * Parameters: out - the stream to print to
+    *             money - the Money to print
+    * Returns: out so prints can be chained
+    * Side Effects: the amount is written to out
+    */
+    friend ostream &operator<<(ostream &out, const Money &money);
+
+private:
+    // constructor used by the factory methods
+    explicit constexpr Money(long long micros) : micros(micros) {}
+}; // Class Money
+
+/* 
+* Purpose: To read a decimal number from text as a whole number of units of a given precision
+* Parameters: text - the text to read, leading whitespace is skipped
+*             scale - the number of units in one (100 for hundredths)
+* Returns: the number rounded to the nearest unit, halves away from zero. 0 if the text does not start with a number.
+*          A number too large to hold gives LLONG_MAX (or -LLONG_MAX), which every range check rejects
+* Side Effects: NONE
+*/
+long long parseScaledDecimal(string_view text, long long scale) {
+    size_t i = 0;
+    while ((i < text.size()) && isspace((unsigned char)text[i])) {
+        i++;
+    }
+    bool negative = false;
+    if ((i < text.size()) && ((text[i] == '-') || (text[i] == '+'))) {
+        negative = text[i] == '-';
+        i++;
+    }
+    // whole part of the number. It is kept below LLONG_MAX / scale - 1 so scaling it and adding
+    // the fraction and rounding can never overflow
+    const long long largestWhole = LLONG_MAX / scale - 1;
+    long long value = 0;
+    while ((i < text.size()) && isdigit((unsigned char)text[i])) {
+        if (value > (largestWhole - (text[i] - '0')) / 10) {
+            return negative ? -LLONG_MAX : LLONG_MAX;
+        }
+        value = value * 10 + (text[i] - '0');
+        i++;
+    }
+    value *= scale;
+    // fraction digits are added until the scale runs out, the first digit after that decides the rounding
+    if ((i < text.size()) && (text[i] == '.')) {
+        i++;
+        long long place = scale / 10;
+        while ((i < text.size()) && isdigit((unsigned char)text[i])) {
+            if (place > 0) {
+                value += (text[i] - '0') * place;
+                place /= 10;
+            } else {
+                if (text[i] >= '5') {
+                    value++;
+                }
+                break;
+            }
+            i++;
+        }
+    }
+    return negative ? -value : value;
+}
+
+// longest text formatInteger and formatHundredths can write, including the sign
+const size_t MAX_FORMATTED_CHARS = 24;
+
+/* 
+* Purpose: To write a whole number as text. The digits are written backwards from the end of
+*          a buffer so no length has to be worked out first
+* Parameters: end - one past the last character of the buffer, which must hold MAX_FORMATTED_CHARS
+*             value - the number to write
+* Returns: a pointer to the first character of the text, which runs up to end
+* Side Effects: the text is written to the buffer
+*/
+char *formatInteger(char *end, long long value) {
+    // work with the magnitude unsigned so the most negative number does not overflow
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    char *begin = end;
+    do {
+        *--begin = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        *--begin = '-';
+    }
+    return begin;
+}
+
+/* 
+* Purpose: To write a whole number of hundredths as text with two decimal places, the same
+*          way setprecision(2) and fixed print it
+* Parameters: end - one past the last character of the buffer, which must hold MAX_FORMATTED_CHARS
+*             hundredths - the number to write
+* Returns: a pointer to the first character of the text, which runs up to end
+* Side Effects: the text is written to the buffer
+*/
+char *formatHundredths(char *end, long long hundredths) {
+    unsigned long long magnitude = hundredths < 0 ? 0ULL - (unsigned long long)hundredths : (unsigned long long)hundredths;
+    char *begin = end;
+    *--begin = (char)('0' + magnitude % 10);
+    *--begin = (char)('0' + magnitude / 10 % 10);
+    *--begin = '.';
+    magnitude /= 100;
+    do {
+        *--begin = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (hundredths < 0) {
+        *--begin = '-';
+    }
+    return begin;
+}
+
+/* 
+* Purpose: To print a whole number of hundredths with two decimal places
+* Parameters: out - the stream to print to
+*             hundredths - the number to print
+* Returns: out so prints can be chained
+* Side Effects: the number is written to out
+*/
+ostream &printHundredths(ostream &out, long long hundredths) {
+    char text[MAX_FORMATTED_CHARS];
+    char *end = text + MAX_FORMATTED_CHARS;
+    char *begin = formatHundredths(end, hundredths);
+    return out.write(begin, end - begin);
+}
+
+Hours Hours::parse(string_view text) {return fromHundredths(parseScaledDecimal(text, HUNDREDTHS_PER_HOUR));}
+ostream &operator<<(ostream &out, const Hours &hours) {return printHundredths(out, hours.hundredths);}
+Money Money::parse(string_view text) {return fromMicros(parseScaledDecimal(text, MICROS_PER_DOLLAR));}
+ostream &operator<<(ostream &out, const Money &money) {return printHundredths(out, money.getCents());}
+
+// max num of each employee type. These are no longer storage limits, they are only
+// enforced as a staffing policy when the policy checks are turned on (see RosterPolicy)
 const int MAX_MANAGERS = 4;
 const int MAX_ACCOUNTANTS = 3;
 const int MAX_SECRETARIES = 7;
@@ -21,23 +329,300 @@ const int MAX_HR = 2;
 const int MAX_SALESPEOPLE = 30;
 // maximum number of employees
 const int MAX_EMPLOYEES = MAX_MANAGERS + MAX_ACCOUNTANTS + MAX_SECRETARIES + MAX_HR + MAX_SALESPEOPLE;
+// rough size of one employee record in an input file, used to guess how many
+// employees a file holds so the roster can reserve its storage up front
+const long AVERAGE_RECORD_BYTES = 64;
 // hours an employee works in a standard work week
-const double STANDARD_WEEKLY_HOURS = 40;
-const double HOURS_IN_A_WEEK = 24 * 7;
+constexpr Hours STANDARD_WEEKLY_HOURS = Hours::fromWhole(40);
+constexpr Hours HOURS_IN_A_WEEK = Hours::fromWhole(24 * 7);
+// the legal limit on the hours an hourly based employee can work in a week
+constexpr Hours HOURLY_HOURS_LIMIT = Hours::fromWhole(60);
+
+// constants for the commission rates of different types of salespeople in basis points (200 is 2%)
+const int JUNIOR_COMMISSION_RATE = 200;
+const int SENIOR_COMMISSION_RATE = 300;
+
+// constants for the hours needed to earn overtime and the overtime pay multiplier
+// (in percent, 150 is one and a half times) of hourly based employees
+constexpr Hours SECRETARY_OVERTIME_HOURS = Hours::fromWhole(40);
+const int SECRETARY_OVERTIME_MULTIPLIER = 150;
+constexpr Hours HR_OVERTIME_HOURS = Hours::fromWhole(44);
+const int HR_OVERTIME_MULTIPLIER = 200;
+
+// number of employees of one position the payroll engine calculates as a single unit of work.
+// Chunks are the same no matter how many threads are used so totals are always added in the same order
+const size_t PAYROLL_CHUNK_SIZE = 4096;
+// size of a cache line, used to keep values written by different threads apart
+const size_t CACHE_LINE_BYTES = 64;
+
+// number of employees read in and printed at a time in streaming mode. Only this many
+// employees are ever in memory at once
+const size_t STREAM_BATCH_SIZE = 4096;
+
+// size of each block of memory the employee arena allocates at once
+const size_t ARENA_BLOCK_BYTES = 64 * 1024;
+
+// number of bytes of report text collected before it is written out in one go
+const size_t REPORT_BUFFER_BYTES = 1024 * 1024;
+// number of employees whose reports one thread renders as a single unit of work, and
+// the number of these chunks each thread renders before the finished text is printed
+const size_t REPORT_CHUNK_SIZE = 1024;
+const size_t REPORT_CHUNKS_PER_THREAD = 4;
+
+// number of heap allocations made by the whole program, used to show
+// how many allocations reading in each employee costs. Allocations are only
+// counted when countHeapAllocations is set, which main() does for --alloc-stats
+// and --bench before any other thread is started
+atomic<size_t> heapAllocations(0);
+bool countHeapAllocations = false;
+
+// the replacement allocation functions are kept out of line. If GCC inlines them it sees
+// free() called on memory from operator new and warns about a mismatched new and delete
+#if defined(__GNUC__)
+#define EMPLOYEE_NOINLINE __attribute__((noinline))
+#else
+#define EMPLOYEE_NOINLINE
+#endif
+
+/* 
+* Purpose: To replace the global allocation functions so heap allocations can be counted
+* Parameters: size - the number of bytes to allocate
+* Returns: a pointer to the allocated memory
+* Side Effects: heapAllocations is incremented if countHeapAllocations is set,
+*               std::bad_alloc is thrown if there is no memory left
+*/
+EMPLOYEE_NOINLINE void *operator new(size_t size) {
+    if (countHeapAllocations) {
+        heapAllocations.fetch_add(1, memory_order_relaxed);
+    }
+    void *memory = malloc(size > 0 ? size : 1);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+EMPLOYEE_NOINLINE void *operator new[](size_t size) {return operator new(size);}
+// every form of delete goes through the one below so it always matches the malloc() in new
+EMPLOYEE_NOINLINE void operator delete(void *memory) noexcept {free(memory);}
+EMPLOYEE_NOINLINE void operator delete[](void *memory) noexcept {operator delete(memory);}
+EMPLOYEE_NOINLINE void operator delete(void *memory, size_t) noexcept {operator delete(memory);}
+EMPLOYEE_NOINLINE void operator delete[](void *memory, size_t) noexcept {operator delete(memory);}
+
+/* 
+* Purpose: To find how many threads to use for some number of items of work
+* Parameters: threads - the number of threads asked for, 0 to use every core
+*             items - the number of items of work, there is no point using more threads than items
+* Returns: the number of threads, at least one
+* Side Effects: NONE
+*/
+unsigned threadsFor(unsigned threads, size_t items) {
+    if (threads == 0) {
+        threads = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+    }
+    if (threads > items) {
+        threads = items > 0 ? (unsigned)items : 1;
+    }
+    return threads;
+}
 
-// constants for the commission rates of different types of salespeople
-const double JUNIOR_COMMISSION_RATE = 0.02;
-const double SENIOR_COMMISSION_RATE = 0.03;
+/* 
+* Purpose: To do numbered items of work on several threads. Each thread takes the next item nobody
+*          has started until there are none left, and the calling thread works as well instead of waiting
+* Parameters: threads - the number of threads to use, 0 to use every core
+*             items - the number of items
+*             work - called as work(item) once for each item from 0 to items - 1, on any of the threads
+*             finish - called on the calling thread once it finds no items left to start, while the
+*                      other threads may still be working on theirs
+* Returns: NONE
+* Side Effects: whatever work and finish do, every item is done when it returns
+*/
+template <typename Work, typename Finish>
+void runOnThreads(unsigned threads, size_t items, Work work, Finish finish) {
+    threads = threadsFor(threads, items);
+    atomic<size_t> nextItem(0);
+    auto worker = [&]() {
+        for (size_t item = nextItem.fetch_add(1); item < items; item = nextItem.fetch_add(1)) {
+            work(item);
+        }
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; t++) {
+        pool.push_back(thread(worker));
+    }
+    worker();
+    finish();
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+}
 
+/* 
+* Purpose: To do numbered items of work on several threads, see runOnThreads above
+* Parameters: threads - the number of threads to use, 0 to use every core
+*             items - the number of items
+*             work - called as work(item) once for each item from 0 to items - 1, on any of the threads
+* Returns: NONE
+* Side Effects: whatever work does, every item is done when it returns
+*/
+template <typename Work>
+void runOnThreads(unsigned threads, size_t items, Work work) {
+    runOnThreads(threads, items, work, []() {});
+}
 
+// headings of each section of the reports
+const string payReportHeading = "-------- Printing Pay Information Report --------";
+const string employeeReportHeading = "-------- Printing Employee Information Report --------";
+const string chequesHeading = "-------- Printing Cheques --------";
+const string summaryHeading = "-------- Company Summary --------";
+const string batchSummaryHeading = "-------- Batch Summary --------";
+const string combinedSummaryHeading = "-------- Combined Summary --------";
+// added to the name of a roster file to name the file its reports are written to when running many companies
+const string COMPANY_OUTPUT_EXTENSION = ".out";
+// the statuses of a company that could not be run because of its files, alongside the exit statuses of a run
+const int COMPANY_MISSING = -1;
+const int COMPANY_UNWRITABLE = -2;
 
 // strings for each position at the company
-const string managerPos = "manager";
-const string accountantPos = "accountant";
-const string secretaryPos = "secretary";
-const string HRPos = "human resource";
-const string juniorSalesPos = "junior salesperson";
-const string seniorSalesPos = "senior salesperson";
+constexpr char managerPos[] = "manager";
+constexpr char accountantPos[] = "accountant";
+constexpr char secretaryPos[] = "secretary";
+constexpr char HRPos[] = "human resource";
+constexpr char juniorSalesPos[] = "junior salesperson";
+constexpr char seniorSalesPos[] = "senior salesperson";
+// tags for each position at the company, a tag is the index of the position in the POSITIONS table
+enum PositionTag {MANAGER, ACCOUNTANT, SECRETARY, HUMAN_RESOURCE, JUNIOR_SALES, SENIOR_SALES, NUM_POSITIONS};
+
+/* 
+* Class: ReportWriter
+* Purpose: A class that collects report text in a large buffer and writes it to a stream
+           in big pieces. Unlike printing each line with endl, lines are never flushed on their
+           own, and numbers are formatted with formatInteger and formatHundredths instead of
+           the stream's formatting, which gives the same text
+*/
+class ReportWriter {
+private:
+    // the stream the reports are written to, nullptr if the text is only kept in memory
+    ostream *out;
+    // the report text not yet written to out
+    string buffer;
+    // number of bytes written to out
+    size_t bytesWritten = 0;
+
+public:
+    /* 
+    * Purpose: To construct/initialize a ReportWriter that writes to a stream
+    * Parameters: out - the stream the reports are written to
+    * Returns: Not Applicable
+    * Side Effects: REPORT_BUFFER_BYTES are reserved for the buffer
+    */
+    explicit ReportWriter(ostream &out) : out(&out) {
+        buffer.reserve(REPORT_BUFFER_BYTES);
+    }
+
+    /* 
+    * Purpose: To construct/initialize a ReportWriter that keeps all of its text in memory,
+    *          used to render part of a report that is printed later
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    ReportWriter() : out(nullptr) {}
+
+    /* 
+    * Purpose: To write out anything left in the buffer when a ReportWriter is destroyed
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: flush is called
+    */
+    ~ReportWriter() {
+        flush();
+    }
+
+    ReportWriter(const ReportWriter &) = delete;
+    ReportWriter &operator=(const ReportWriter &) = delete;
+
+    /* 
+    * Purpose: To add text to the report
+    * Parameters: text - the text to add
+    *             length - the number of characters in the text
+    * Returns: NONE
+    * Side Effects: the text is added to the buffer, which is written out once it is full
+    */
+    void write(const char *text, size_t length) {
+        // text too large to be worth buffering is written straight out after what is already buffered
+        if ((out != nullptr) && (length >= REPORT_BUFFER_BYTES)) {
+            flush();
+            out->write(text, length);
+            bytesWritten += length;
+            return;
+        }
+        buffer.append(text, length);
+        if ((out != nullptr) && (buffer.size() >= REPORT_BUFFER_BYTES)) {
+            flush();
+        }
+    }
+
+    /* 
+    * Purpose: To write everything in the buffer to the stream
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: the buffer is written to out and emptied, out itself is not flushed.
+    *               Nothing happens if the ReportWriter has no stream
+    */
+    void flush() {
+        if ((out != nullptr) && !buffer.empty()) {
+            out->write(buffer.data(), buffer.size());
+            bytesWritten += buffer.size();
+            buffer.clear();
+        }
+    }
+
+    // get methods, getText is the text not yet written out
+    string_view getText() const {return buffer;}
+    size_t getBytesWritten() const {return bytesWritten;}
+
+    /* 
+    * Purpose: To throw away the text not yet written out, so a ReportWriter
+    *          without a stream can be used again
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: the buffer is emptied, its memory is kept
+    */
+    void clear() {
+        buffer.clear();
+    }
+
+    // operators to add text, numbers, Money and Hours to the report
+    ReportWriter &operator<<(string_view text) {write(text.data(), text.size()); return *this;}
+    ReportWriter &operator<<(const char *text) {return *this << string_view(text);}
+    ReportWriter &operator<<(char character) {write(&character, 1); return *this;}
+    ReportWriter &operator<<(long long value) {
+        char text[MAX_FORMATTED_CHARS];
+        char *end = text + MAX_FORMATTED_CHARS;
+        char *begin = formatInteger(end, value);
+        write(begin, end - begin);
+        return *this;
+    }
+    ReportWriter &operator<<(int value) {return *this << (long long)value;}
+    ReportWriter &operator<<(size_t value) {return *this << (long long)value;}
+    ReportWriter &operator<<(Hours hours) {return writeHundredths(hours.getHundredths());}
+    ReportWriter &operator<<(Money money) {return writeHundredths(money.getCents());}
+
+private:
+    /* 
+    * Purpose: To add a whole number of hundredths to the report with two decimal places
+    * Parameters: hundredths - the number to add
+    * Returns: this ReportWriter so writes can be chained
+    * Side Effects: the number is added to the buffer
+    */
+    ReportWriter &writeHundredths(long long hundredths) {
+        char text[MAX_FORMATTED_CHARS];
+        char *end = text + MAX_FORMATTED_CHARS;
+        char *begin = formatHundredths(end, hundredths);
+        write(begin, end - begin);
+        return *this;
+    }
+}; // Class ReportWriter
 
 /* 
 * Class: Name
@@ -46,9 +631,9 @@ const string seniorSalesPos = "senior salesperson";
 */
 class Name {
 private:
-    // strings for first and last name
-    string firstName;
-    string lastName;
+    // views of the first and last name, the text is owned by the roster the person belongs to
+    string_view firstName;
+    string_view lastName;
 
 public:
     /* 
@@ -57,66 +642,153 @@ public:
     *             lastName - the last name of a person
     * Returns: Not Applicable
     * Side Effects: the first and last name member variables 
-    *               are set to the passed in values.
+    *               are set to the passed in values in the initializers list.
     */
-    Name(string firstName, string lastName) {
-        this->firstName = firstName;
-        this->lastName = lastName;
-    }
+    Name(string_view firstName, string_view lastName) : firstName(firstName), lastName(lastName) {}
 
     // get methods
-    virtual string getFirstName() const {return firstName;}
-    virtual string getLastName() const {return lastName;}
+    virtual string_view getFirstName() const {return firstName;}
+    virtual string_view getLastName() const {return lastName;}
 
     /* 
     * Purpose: To print a Name
     * Parameters: lastNameFirst - an bool for whether the last name will be printed before the first name or not
     *             seperator - a character that will seperate the last and first names when printed (if last name is first) 
+    *             out - the stream to print to
     * Returns: NONE
     * Side Effects: NONE - method is constant
     */
-    virtual void print(bool lastNameFirst, char seperator) const {
+    virtual void print(bool lastNameFirst, char seperator, ostream &out = cout) const {
         // if last name is first, print name with last name first followed by seperator and first name
         if (lastNameFirst) {
-            cout << lastName << seperator << " " << firstName;
+            out << lastName << seperator << " " << firstName;
         // first name is printed first, followed by the last name
         } else {
-            cout << firstName << " " << lastName;
+            out << firstName << " " << lastName;
+        }
+    }
+
+    /* 
+    * Purpose: To print a Name in a report, the same way as print above
+    * Parameters: lastNameFirst - an bool for whether the last name will be printed before the first name or not
+    *             seperator - a character that will seperate the last and first names when printed (if last name is first) 
+    *             out - the report to print to
+    * Returns: NONE
+    * Side Effects: NONE - method is constant
+    */
+    virtual void print(bool lastNameFirst, char seperator, ReportWriter &out) const {
+        if (lastNameFirst) {
+            out << lastName << seperator << ' ' << firstName;
+        } else {
+            out << firstName << ' ' << lastName;
         }
     }
 }; // Class Name
 
+// names of the months, indexed by month number (1 is January). Index 0 is used for unknown months
+const string_view MONTH_NAMES[13] = {"", "January", "February", "March", "April", "May", "June", "July",
+                                     "August", "September", "October", "November", "December"};
+
+/* 
+* Purpose: To find the number of a month from its name. Whitespace around the name is ignored,
+*          case does not matter and the first three letters (such as "Jan") are accepted
+* Parameters: text - the name of the month
+* Returns: the number of the month from 1 (January) to 12 (December), 0 if it is not a month
+* Side Effects: NONE
+*/
+int parseMonth(string_view text) {
+    while (!text.empty() && isspace((unsigned char)text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isspace((unsigned char)text.back())) {
+        text.remove_suffix(1);
+    }
+    if (text.size() < 3) {
+        return 0;
+    }
+    // the first three letters tell every month apart, so only the candidate month is compared in full
+    char first = (char)tolower((unsigned char)text[0]);
+    char second = (char)tolower((unsigned char)text[1]);
+    char third = (char)tolower((unsigned char)text[2]);
+    int month = 0;
+    switch (first) {
+        case 'j': month = second == 'a' ? 1 : (third == 'n' ? 6 : 7); break;
+        case 'f': month = 2; break;
+        case 'm': month = third == 'r' ? 3 : 5; break;
+        case 'a': month = second == 'p' ? 4 : 8; break;
+        case 's': month = 9; break;
+        case 'o': month = 10; break;
+        case 'n': month = 11; break;
+        case 'd': month = 12; break;
+        default: return 0;
+    }
+    const string_view name = MONTH_NAMES[month];
+    if ((text.size() != 3) && (text.size() != name.size())) {
+        return 0;
+    }
+    for (size_t i = 0; i < text.size(); i++) {
+        if (tolower((unsigned char)text[i]) != tolower((unsigned char)name[i])) {
+            return 0;
+        }
+    }
+    return month;
+}
+
 /* 
 * Class: Date
 * Purpose: A class that contains the elements of a Date
            and methods to perform certain actions on/with
-           these elements
+           these elements. The year, month number and day are packed into
+           32 bits (year << 9 | month << 5 | day) so dates compare and subtract
+           as plain integers. Only days from 0 to 31 and years from 0 to MAX_YEAR
+           fit in the packed date, so the month as it was spelled and the day and
+           year as they were read are also kept, and a Date always prints exactly
+           as it was read. isPackable tells whether the packed date can be used
 */
 class Date {
 private:
-    // variables for the month, day, and year of a date
-    string month;
+    // the month as it was spelled, a view of text owned by the roster the date belongs to
+    const char *monthSpelling;
+    uint32_t monthSpellingLength;
+    // the packed year, month number and day
+    uint32_t packed;
+    // the day and year as they were read, even if they do not fit in the packed date
     int day;
     int year;
 
 public:
+    // the largest year a Date can hold
+    static const int MAX_YEAR = (1 << 23) - 1;
+
     /* 
     * Purpose: To construct/initialize a Date object given values for its member variables
     * Parameters: month - the month of the Date
     *             day - the day of the Date
     *             year - the year of the Date
     * Returns: Not Applicable
-    * Side Effects: setDate() is called to set the date and modify the member variables of the Date
+    * Side Effects: the member variables are set in the initializers list, the same way setDate sets them
     */
-    Date(string month, int day, int year) {
-        // set date with the values passed into the constructor
-        setDate(month, day, year);
-    }
+    Date(string_view month, int day, int year) :
+        monthSpelling(month.data()), monthSpellingLength((uint32_t)month.size()), packed(pack(month, day, year)),
+        day(day), year(year) {}
 
     // get methods
-    virtual string getMonth() const {return month;}
+    virtual string_view getMonth() const {return string_view(monthSpelling, monthSpellingLength);}
+    virtual int getMonthNumber() const {return (packed >> 5) & 0xF;}
     virtual int getDay() const {return day;}
     virtual int getYear() const {return year;}
+    virtual uint32_t getPacked() const {return packed;}
+
+    /* 
+    * Purpose: To tell whether the packed date is the date that was read, which is when the month
+    *          is known, the day is from 1 to 31 and the year is from 0 to MAX_YEAR
+    * Parameters: NONE
+    * Returns: true if the packed date can be compared and used to work out ages, false if not
+    * Side Effects: NONE
+    */
+    virtual bool isPackable() const {
+        return (getMonthNumber() != 0) && (day >= 1) && (day <= 31) && (year >= 0) && (year <= MAX_YEAR);
+    }
 
     /* 
     * Purpose: To set the values of the member variables of a Date
@@ -127,25 +799,85 @@ public:
     * Side Effects: The member variables of the Date are updated
     *               with the passed in values
     */
-    virtual void setDate(string month, int day, int year) {
-        // set month day and year with the values passed into the method
-        this->month = month;
+    virtual void setDate(string_view month, int day, int year) {
+        // keep the spelling of the month and pack its number with the day and year
+        monthSpelling = month.data();
+        monthSpellingLength = (uint32_t)month.size();
+        packed = pack(month, day, year);
         this->day = day;
         this->year = year;
     }
 
+    /* 
+    * Purpose: To pack a date into 32 bits, clamping the day and year to the ranges that fit
+    * Parameters: month - the month of the date
+    *             day - the day of the date
+    *             year - the year of the date
+    * Returns: the packed date
+    * Side Effects: NONE
+    */
+    static uint32_t pack(string_view month, int day, int year) {
+        day = day < 0 ? 0 : (day > 31 ? 31 : day);
+        year = year < 0 ? 0 : (year > MAX_YEAR ? MAX_YEAR : year);
+        return ((uint32_t)year << 9) | ((uint32_t)parseMonth(month) << 5) | (uint32_t)day;
+    }
+
+    /* 
+    * Purpose: To find how many whole years have passed from this Date until another, such as
+    *          the age on a given day of a person born on this Date. Both dates should be packable
+    * Parameters: other - the later date
+    * Returns: the number of whole years, negative if other is before this Date
+    * Side Effects: NONE
+    */
+    virtual int yearsUntil(const Date &other) const {
+        int years = (int)(other.packed >> 9) - (int)(packed >> 9);
+        // the low 9 bits are the month and day, so a year is not complete until they are reached
+        if ((other.packed & 0x1FF) < (packed & 0x1FF)) {
+            years--;
+        }
+        return years;
+    }
+
+    // comparison operators, earlier dates are smaller
+    bool operator<(const Date &other) const {return packed < other.packed;}
+    bool operator==(const Date &other) const {return packed == other.packed;}
+
     /* 
     * Purpose: To print a Date
-    * Parameters: NONE
+    * Parameters: out - the report to print to
     * Returns: NONE
     * Side Effects: NONE - function is constant
     */
-    virtual void print() const {
+    virtual void print(ReportWriter &out) const {
         // print date in the format of month day, year.
-        cout << month << " " << day << ", " << year;
+        out << getMonth() << ' ' << getDay() << ", " << getYear();
     }
 }; // Class Date
 
+// packed SIN of a SIN that is not a number, such SINs are never indexed
+const uint64_t NO_SIN = 0;
+
+/* 
+* Purpose: To pack a SIN into a single number. The number of digits is kept in the top 4 bits
+*          so SINs that only differ by leading zeros (such as "000000001" and "1") stay different
+* Parameters: SIN - the text of the SIN
+* Returns: the packed SIN, NO_SIN if the SIN is empty, has more than 15 digits or is not all digits
+* Side Effects: NONE
+*/
+uint64_t parseSIN(string_view SIN) {
+    if (SIN.empty() || (SIN.size() > 15)) {
+        return NO_SIN;
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < SIN.size(); i++) {
+        if ((SIN[i] < '0') || (SIN[i] > '9')) {
+            return NO_SIN;
+        }
+        value = value * 10 + (uint64_t)(SIN[i] - '0');
+    }
+    return ((uint64_t)SIN.size() << 60) | value;
+}
+
 /* 
 * Class: PersonalInfo
 * Purpose: A class that contains a persons personal work information
@@ -156,7 +888,9 @@ private:
     // name, birthday and SIN make up a persons personal work information
     Name name;
     Date birthday;
-    string SIN;
+    string_view SIN;
+    // the SIN packed by parseSIN, used to find a person by their SIN
+    uint64_t packedSIN;
 public:
     /* 
     * Purpose: To construct/initialize a PersonalInfo object given values for its member variables
@@ -168,20 +902,18 @@ public:
     *             SIN - a persons Social Insurance Number
     * Returns: Not Applicable
     * Side Effects: Name and Birthday objects (name and birthday) constructors are called to initialize them
-    *               in the initializers list and the member variable SIN is set to the passed in value.
+    *               in the initializers list, where the member variable SIN is also set to the passed in value and packed.
     */
-    PersonalInfo(string firstName, string lastName, string birthMonth, int birthDay, int birthYear, string SIN) :
-                name(firstName, lastName), birthday(birthMonth, birthDay, birthYear) {
-        // set the SIN of this object to the SIN passed in to the constructor
-        this->SIN = SIN;
-    }
+    PersonalInfo(string_view firstName, string_view lastName, string_view birthMonth, int birthDay, int birthYear, string_view SIN) :
+                name(firstName, lastName), birthday(birthMonth, birthDay, birthYear), SIN(SIN), packedSIN(parseSIN(SIN)) {}
 
     // get methods
     // getName and getDate return pointers to a name and date so
     // methods from each class can be called
     virtual const Name *getName() const {return &name;}
     virtual const Date *getDate() const {return &birthday;}
-    virtual string getSIN() const {return SIN;}
+    virtual string_view getSIN() const {return SIN;}
+    virtual uint64_t getPackedSIN() const {return packedSIN;}
 };
 
 /* 
@@ -192,11 +924,11 @@ public:
 class PayInfo {
 private:
 // variables for a person/workers pay rate and the number of hours they worked in a week
-    double payRate;
-    double hoursWorked;
+    Money payRate;
+    Hours hoursWorked;
 public:
     // the minimum legal wage for work as specified by Canadian/Tam labour laws
-    static const double minimumWage;
+    static const Money minimumWage;
 
 public:
     /* 
@@ -207,30 +939,31 @@ public:
     * Side Effects: setPayRate and setHoursWorked are called which modify member variables
     *               if the passed in values are valid
     */
-    PayInfo(double payRate, double hoursWorked) {
+    PayInfo(Money payRate, Hours hoursWorked) {
         // set pay rate and hours worked
         setPayRate(payRate);
         setHoursWorked(hoursWorked);
     }
 
     // get methods
-    virtual double getPayRate() const {return payRate;}
-    virtual double getHoursWorked() const {return hoursWorked;}
+    virtual Money getPayRate() const {return payRate;}
+    virtual Hours getHoursWorked() const {return hoursWorked;}
 
     /* 
     * Purpose: To set a persons hourly pay rate
     * Parameters: payRate - the persons hourly pay rate
     * Returns: false if payRate is less than the legal minimum wage, true if it is greater than or equal to the minimum wage
-    * Side Effects: the payRate member variable is modified if the passed in payRate is greater than or equal to the minimum wage
+    * Side Effects: the payRate member variable is modified if the passed in payRate is greater than or equal to the minimum wage.
+    *               Pay rates are rounded to the nearest cent
     */
-    virtual bool setPayRate(double payRate) {
+    virtual bool setPayRate(Money payRate) {
         // if pay rate is less than minimum wage return false so other classes 
         // that call this function can perform actions depending on the context
         if (payRate < minimumWage) {
             return false;
         }
         // set pay rate and return true
-        this->payRate = payRate;
+        this->payRate = payRate.roundedToCents();
         return true;
     }
 
@@ -241,10 +974,10 @@ public:
     *          a week, true if the number of hours is between this range
     * Side Effects: 
     */
-    virtual bool setHoursWorked(double hoursWorked) {
+    virtual bool setHoursWorked(Hours hoursWorked) {
         // if hours worked is less than 0 or greater than the number of hours in a week
         // return false so other classes that call this function can perform actions depending on the context
-        if ((hoursWorked < 0) || (hoursWorked > (HOURS_IN_A_WEEK) )) {
+        if ((hoursWorked < Hours()) || (hoursWorked > (HOURS_IN_A_WEEK) )) {
             return false;
         } 
         // set hours worked and return true
@@ -254,61 +987,364 @@ public:
 
 }; // Class PayInfo
 // set minimum wage of PayInfo to $14/hour
-const double PayInfo::minimumWage = 14;
+const Money PayInfo::minimumWage = Money::fromDollars(14);
 
 /* 
-* Class: Employee
-* Purpose: A class to store the information of an employee in a company
-           and methods to perform actions on/with this information
+* Class: PayrollLedger
+* Purpose: Running totals of the weekly pay of a group of employees, for the whole group and
+           for each position. Employees attached to a ledger add the change in their weekly pay
+           to it whenever it changes, so the totals are always up to date without adding up every
+           employee again. The totals are atomic so employees can change on several threads at once
 */
-class Employee {
+class PayrollLedger {
 private:
-    // privatemember variables for an employees position, personalInfo (see class PersonalInfo),
-    // and payInfo (see class PayInfo). These only need to be accessed by the employee class and 
-    // should not be changed without any validation by any child classes that do not understand the context
-    string position;
-    PersonalInfo personalInfo;
-    PayInfo payInfo;
-    // variable for an employees weekly pay
-    double weeklyPay;
-
-public:
-    // class variable for the maximum hourly wage the company will pay an employee 
-    static const double maximumCompanyWage;
+    // total weekly pay in micros and number of employees, for each position and for every position
+    atomic<long long> positionPay[NUM_POSITIONS];
+    atomic<size_t> positionCount[NUM_POSITIONS];
+    atomic<long long> totalPay;
+    atomic<size_t> totalCount;
 
 public:
     /* 
-    * Purpose: To construct/initialize an Employee object with values for the member variables passed in to the constructor
-    * Parameters: position - an employees position/job in the company
-    *             firstName - an employees first name
-    *             lastName - an employees last name
-    *             SIN - an employee social insurance number
-    *             birthMonth - the month an employee was born in
-    *             birthDay - the day of the month an employee was born on
-    *             birthYear - the year an employee was born in
-    *             payRate - the employees hourly pay rate
-    *             hoursWorked - the number of hours the employee worked in a week
+    * Purpose: To construct/initialize an empty PayrollLedger
+    * Parameters: NONE
     * Returns: Not Applicable
-    * Side Effects: position member variable is set, setPayRate and setHoursWorked are called which 
-    *               modify member variables to set the payRate and hoursWorked member variables. In the
-    *               initializers list personalInfo and payInfos constructors are called which modify member 
-    *               variables of those classes
-    */
-    Employee(string position, string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked):
-            personalInfo(firstName, lastName, birthMonth, birthDay, birthYear, SIN), payInfo(payRate, hoursWorked) {
-        // set position to the position passed into the constructor
-        this->position = position;
-        // set the employees pay rate 
-        setPayRate(payRate);
-        // set the hours the employee worked
-        setHoursWorked(hoursWorked);
-    };
+    * Side Effects: every total is set to 0
+    */
+    PayrollLedger() : totalPay(0), totalCount(0) {
+        for (int p = 0; p < NUM_POSITIONS; p++) {
+            positionPay[p].store(0);
+            positionCount[p].store(0);
+        }
+    }
+
+    // a ledger is shared by the employees attached to it so it cannot be copied
+    PayrollLedger(const PayrollLedger &) = delete;
+    PayrollLedger &operator=(const PayrollLedger &) = delete;
+
+    // get methods
+    Money getTotal() const {return Money::fromMicros(totalPay.load(memory_order_relaxed));}
+    size_t getCount() const {return totalCount.load(memory_order_relaxed);}
+    Money getTotal(PositionTag position) const {return Money::fromMicros(positionPay[position].load(memory_order_relaxed));}
+    size_t getCount(PositionTag position) const {return positionCount[position].load(memory_order_relaxed);}
+
+    /* 
+    * Purpose: To add an employee to the totals, or take one away
+    * Parameters: position - the position of the employee
+    *             weeklyPay - the weekly pay of the employee
+    *             joining - true if the employee is added, false if they are taken away
+    * Returns: NONE
+    * Side Effects: the totals of the position and of every position are updated
+    */
+    void track(PositionTag position, Money weeklyPay, bool joining) {
+        long long pay = joining ? weeklyPay.getMicros() : -weeklyPay.getMicros();
+        positionPay[position].fetch_add(pay, memory_order_relaxed);
+        totalPay.fetch_add(pay, memory_order_relaxed);
+        if (joining) {
+            positionCount[position].fetch_add(1, memory_order_relaxed);
+            totalCount.fetch_add(1, memory_order_relaxed);
+        } else {
+            positionCount[position].fetch_sub(1, memory_order_relaxed);
+            totalCount.fetch_sub(1, memory_order_relaxed);
+        }
+    }
+
+    /* 
+    * Purpose: To add the change in the weekly pay of an employee to the totals
+    * Parameters: position - the position of the employee
+    *             change - the new weekly pay minus the old weekly pay
+    * Returns: NONE
+    * Side Effects: the totals of the position and of every position are updated
+    */
+    void adjust(PositionTag position, Money change) {
+        positionPay[position].fetch_add(change.getMicros(), memory_order_relaxed);
+        totalPay.fetch_add(change.getMicros(), memory_order_relaxed);
+    }
+}; // Class PayrollLedger
+
+// the checks an employee's pay information can fail when it is set
+enum ValidationRule {PAY_RATE_INVALID, HOURS_INVALID, HOURS_OVER_LIMIT, SALES_NEGATIVE};
+
+/* 
+* Class: ValidationIssue
+* Purpose: A value an employee was given that failed a check and was replaced
+*/
+struct ValidationIssue {
+    // the employee in their roster
+    size_t slot;
+    // where in the input the value came from, issues are printed in this order
+    size_t order;
+    ValidationRule rule;
+    // the value that was replaced, in micros for money and hundredths for hours
+    long long value;
+};
+
+/* 
+* Class: ValidationLog
+* Purpose: The validation issues found while a roster is read or changed, kept until they are printed
+           together afterwards so the employees never write to a stream while they are calculated.
+           Issues are appended without a lock, so employees can be checked on several threads at once.
+           The issues are stored in blocks that double in size and are never moved, and are kept when
+           the log is cleared so a log that is reused does not allocate again
+*/
+class ValidationLog {
+private:
+    static constexpr size_t FIRST_BLOCK_ISSUES = 64;
+    static constexpr size_t MAX_BLOCKS = 48;
+    // block b holds FIRST_BLOCK_ISSUES << b issues, blocks are allocated the first time they are needed
+    atomic<ValidationIssue *> blocks[MAX_BLOCKS];
+    // number of issues appended
+    atomic<size_t> count;
+
+public:
+    /* 
+    * Class: Scope
+    * Purpose: The employee being checked on the current thread and the log their issues go to.
+               Employees report issues to the innermost scope of their thread
+    */
+    class Scope {
+    private:
+        ValidationLog &log;
+        size_t slot;
+        size_t order;
+        Scope *outer;
+        static thread_local Scope *current;
+
+    public:
+        /* 
+        * Purpose: To start checking an employee on this thread
+        * Parameters: log - the log to add issues to
+        *             slot - the employee in their roster
+        *             order - where in the input the values being checked came from
+        * Returns: Not Applicable
+        * Side Effects: the scope is the current scope of the thread until it is destroyed
+        */
+        Scope(ValidationLog &log, size_t slot, size_t order) : log(log), slot(slot), order(order), outer(current) {
+            current = this;
+        }
+
+        // get methods
+        static Scope *getCurrent() {return current;}
+
+        /* 
+        * Purpose: To stop checking the employee, the scope that was current before becomes current again
+        * Parameters: NONE
+        * Returns: Not Applicable
+        * Side Effects: the current scope of the thread is changed
+        */
+        ~Scope() {
+            current = outer;
+        }
+
+        // a scope belongs to the thread that created it so it cannot be copied
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        /* 
+        * Purpose: To add an issue of the employee being checked to the log
+        * Parameters: rule - the check that failed
+        *             value - the value that was replaced
+        * Returns: NONE
+        * Side Effects: the issue is appended to the log
+        */
+        void record(ValidationRule rule, long long value) {
+            log.append(ValidationIssue{slot, order, rule, value});
+        }
+    }; // Class Scope
+
+    /* 
+    * Purpose: To construct/initialize an empty ValidationLog
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    ValidationLog() : count(0) {
+        for (size_t b = 0; b < MAX_BLOCKS; b++) {
+            blocks[b].store(nullptr);
+        }
+    }
+
+    /* 
+    * Purpose: To free the blocks of the log
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: every block is freed
+    */
+    ~ValidationLog() {
+        for (size_t b = 0; b < MAX_BLOCKS; b++) {
+            delete[] blocks[b].load();
+        }
+    }
+
+    // a log is shared by the threads adding to it so it cannot be copied
+    ValidationLog(const ValidationLog &) = delete;
+    ValidationLog &operator=(const ValidationLog &) = delete;
+
+    // get methods
+    size_t size() const {return count.load(memory_order_acquire);}
+    bool empty() const {return size() == 0;}
+
+    /* 
+    * Purpose: To add an issue to the log, this can be called on several threads at once
+    * Parameters: issue - the issue to add
+    * Returns: NONE
+    * Side Effects: the block the issue goes in is allocated if it is the first issue in it
+    */
+    void append(const ValidationIssue &issue) {
+        size_t index = count.fetch_add(1, memory_order_relaxed);
+        size_t block;
+        size_t offset;
+        locate(index, block, offset);
+        ValidationIssue *issues = blocks[block].load(memory_order_acquire);
+        if (issues == nullptr) {
+            // another thread may be allocating the same block, the first one stored is kept
+            ValidationIssue *fresh = new ValidationIssue[FIRST_BLOCK_ISSUES << block];
+            if (blocks[block].compare_exchange_strong(issues, fresh, memory_order_acq_rel)) {
+                issues = fresh;
+            } else {
+                delete[] fresh;
+            }
+        }
+        issues[offset] = issue;
+    }
+
+    /* 
+    * Purpose: To get the issues in the order of the input they came from. Issues from the same
+    *          place in the input keep the order they were added in. Every thread adding issues
+    *          must have finished
+    * Parameters: NONE
+    * Returns: a copy of the issues in input order
+    * Side Effects: NONE
+    */
+    vector<ValidationIssue> inOrder() const {
+        vector<ValidationIssue> issues;
+        issues.reserve(size());
+        for (size_t i = 0; i < size(); i++) {
+            size_t block;
+            size_t offset;
+            locate(i, block, offset);
+            issues.push_back(blocks[block].load(memory_order_relaxed)[offset]);
+        }
+        stable_sort(issues.begin(), issues.end(), [](const ValidationIssue &a, const ValidationIssue &b) {
+            return a.order < b.order;
+        });
+        return issues;
+    }
+
+    /* 
+    * Purpose: To remove every issue from the log
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: the blocks are kept for the next issues
+    */
+    void clear() {
+        count.store(0, memory_order_release);
+    }
+
+private:
+    /* 
+    * Purpose: To find where an issue is stored
+    * Parameters: index - the number of the issue, counting from 0
+    *             block - set to the block holding the issue
+    *             offset - set to the position of the issue in the block
+    * Returns: NONE
+    * Side Effects: NONE
+    */
+    static void locate(size_t index, size_t &block, size_t &offset) {
+        // block b starts at FIRST_BLOCK_ISSUES * (2^b - 1)
+        size_t blockNumber = index / FIRST_BLOCK_ISSUES + 1;
+        block = 0;
+        while ((blockNumber >> (block + 1)) != 0) {
+            block++;
+        }
+        offset = index - FIRST_BLOCK_ISSUES * ((size_t(1) << block) - 1);
+    }
+}; // Class ValidationLog
+
+thread_local ValidationLog::Scope *ValidationLog::Scope::current = nullptr;
+
+/* 
+* Class: Employee
+* Purpose: A class to store the information of an employee in a company
+           and methods to perform actions on/with this information
+*/
+class Employee {
+private:
+    // privatemember variables for an employees position, personalInfo (see class PersonalInfo),
+    // and payInfo (see class PayInfo). These only need to be accessed by the employee class and 
+    // should not be changed without any validation by any child classes that do not understand the context.
+    // The position is a view of the title in the POSITIONS table
+    string_view position;
+    PersonalInfo personalInfo;
+    PayInfo payInfo;
+    // variable for an employees weekly pay
+    Money weeklyPay;
+    // the ledger the weekly pay of the employee is added to (nullptr for none) and the position it is added under
+    PayrollLedger *ledger = nullptr;
+    PositionTag ledgerPosition = NUM_POSITIONS;
+
+public:
+    // class variable for the maximum hourly wage the company will pay an employee 
+    static const Money maximumCompanyWage;
+
+public:
+    /* 
+    * Purpose: To construct/initialize an Employee object with values for the member variables passed in to the constructor.
+    *          The text passed in is not copied, so it must live as long as the Employee does (see Roster::storeString)
+    * Parameters: position - an employees position/job in the company
+    *             firstName - an employees first name
+    *             lastName - an employees last name
+    *             SIN - an employee social insurance number
+    *             birthMonth - the month an employee was born in
+    *             birthDay - the day of the month an employee was born on
+    *             birthYear - the year an employee was born in
+    *             payRate - the employees hourly pay rate
+    *             hoursWorked - the number of hours the employee worked in a week
+    * Returns: Not Applicable
+    * Side Effects: setPayRate and setHoursWorked are called which modify member variables to set the
+    *               payRate and hoursWorked member variables. In the initializers list position is set and
+    *               personalInfo and payInfos constructors are called which modify member variables of those classes
+    */
+    Employee(string_view position, string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked):
+            position(position), personalInfo(firstName, lastName, birthMonth, birthDay, birthYear, SIN), payInfo(payRate, hoursWorked) {
+        // set the employees pay rate 
+        setPayRate(payRate);
+        // set the hours the employee worked
+        setHoursWorked(hoursWorked);
+    };
+
+    /* 
+    * Purpose: To take the employee out of the ledger they are attached to, also lets an employee be
+    *          destroyed through a pointer to Employee, as the Roster does
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: the weekly pay of the employee is taken away from their ledger
+    */
+    virtual ~Employee() {
+        if (ledger != nullptr) {
+            ledger->track(ledgerPosition, weeklyPay, false);
+        }
+    }
+
+    /* 
+    * Purpose: To attach the employee to a ledger so it always includes their weekly pay
+    * Parameters: ledger - the ledger to attach to
+    *             position - the position the employee is added to the ledger under
+    * Returns: NONE
+    * Side Effects: the weekly pay of the employee is added to the ledger, and any later change
+    *               to it is added to the ledger by setWeeklyPay
+    */
+    virtual void attachLedger(PayrollLedger *ledger, PositionTag position) {
+        this->ledger = ledger;
+        ledgerPosition = position;
+        ledger->track(position, weeklyPay, true);
+    }
 
     // get methods
-    virtual string getPosition() const {return position;}
+    virtual string_view getPosition() const {return position;}
     virtual PayInfo *getPayInfo() {return &payInfo;}
     virtual const PersonalInfo *getPersonalInfo() const {return &personalInfo;}
-    virtual double getWeeklyPay() const {return weeklyPay;}
+    virtual Money getWeeklyPay() const {return weeklyPay;}
 
 public:
     /* 
@@ -318,15 +1354,13 @@ public:
     * Side Effects: payRate member variable is set the the inputted value or 
     *               minimum wage if it is invalid.
     */
-    virtual void setPayRate(double payRate) {
+    virtual void setPayRate(Money payRate) {
         // if pay rate is greater than the maximum company wage or is deemed invalid/illegal by
-        // payInfos setPayRate method, print an error and set pay rate to minimum wage
+        // payInfos setPayRate method, report an error and set pay rate to minimum wage
         // if payInfos setPayRate returns true then the pay rate has been set so
         // it does not need to be set again outside this if statement
         if ((payRate > maximumCompanyWage) || (!payInfo.setPayRate(payRate))) {
-            cout << "ERROR: " << position << " ";
-            personalInfo.getName()->print(false, 'x');
-            cout << " is earning $" << payRate << " per hour. Pay rate will be set to $" << PayInfo::minimumWage << " per hour." << endl;
+            reportIssue(PAY_RATE_INVALID, payRate.getMicros());
             payInfo.setPayRate(PayInfo::minimumWage);
         }
         // calculate the employees weekly pay from scratch as the pay rate has changed
@@ -340,34 +1374,48 @@ public:
     * Side Effects: hoursWorked member variable is modified and set the passed in value 
     *               or 0 if the value is determined to be invalid 
     */
-    virtual void setHoursWorked(double hoursWorked) {
+    virtual void setHoursWorked(Hours hoursWorked) {
         // if payInfos setHoursWorked method returns false, the hours
         // worked passed into the function are not valid/possible to have been worked.
-        // Print error message and set hours worked to 0 so the employee will 
+        // Report an error and set hours worked to 0 so the employee will 
         // know to approach management (C*O Tam) about the issue.
         if(!payInfo.setHoursWorked(hoursWorked)) {
-            cout << "ERROR: " << position << " ";
-            personalInfo.getName()->print(false, 'x');
-            cout << " has worked " << hoursWorked << " hours. Hours will be set to 0." << endl;
-            payInfo.setHoursWorked(0);
+            reportIssue(HOURS_INVALID, hoursWorked.getHundredths());
+            payInfo.setHoursWorked(Hours());
         }
         // calculate the employees weekly pay from scratch as the employees hours worked in the week has changed
         calcWeeklyPay();
     }
 
 protected:
+    /* 
+    * Purpose: To report a value the employee was given that failed a check. The issue is added
+    *          to the validation log of the current ValidationLog::Scope of the thread, or printed
+    *          straight away if there is none
+    * Parameters: rule - the check that failed
+    *             value - the value that was replaced, in micros for money and hundredths for hours
+    * Returns: NONE
+    * Side Effects: the issue is added to a validation log or printed to cout
+    */
+    void reportIssue(ValidationRule rule, long long value) const;
+
     /* 
     * Purpose: To set the employees weeklyPay
     * Parameters: weeklyPay - the employees weeklyPay
     * Returns: NONE
     * Side Effects: weeklyPay member variable is set to the inputted value if it is valid
-    *               or 0 if it is not so employee knows to approach management
+    *               or 0 if it is not so employee knows to approach management. The change
+    *               is added to the ledger the employee is attached to
     */
-   virtual void setWeeklyPay(double weeklyPay) {
-       if (weeklyPay >= 0) {
+   virtual void setWeeklyPay(Money weeklyPay) {
+       Money oldWeeklyPay = this->weeklyPay;
+       if (weeklyPay >= Money()) {
            this->weeklyPay = weeklyPay;
        } else {
-           this->weeklyPay = 0;
+           this->weeklyPay = Money();
+       }
+       if (ledger != nullptr) {
+           ledger->adjust(ledgerPosition, this->weeklyPay - oldWeeklyPay);
        }
    }
 
@@ -384,6 +1432,17 @@ protected:
     virtual void calcWeeklyPay() {};
 
 public:
+    /* 
+    * Purpose: To calculate the employees weekly pay again from their current pay information, without
+    *          setting or checking any of it, such as to time the pay calculation of each position
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: calcWeeklyPay is called which sets the weekly pay of the employee
+    */
+    void recalculateWeeklyPay() {
+        calcWeeklyPay();
+    }
+
     /* 
     * Purpose: To reset the parts of an employees payment information that can vary week by week
     * Parameters: NONE
@@ -395,64 +1454,106 @@ public:
         // weeklyPay as this function calls weeklyPay once the hoursWorked has been changed to ensure
         // the weeklyPay always reflects the pay an employee has earned for the hours they worked.
         // Pay rate is not reset as this is something that does not change often.
-        setHoursWorked(0);
+        setHoursWorked(Hours());
     }
 
 public:
     /* 
     * Purpose: To print the pay information report of an employee
-    * Parameters: NONE
+    * Parameters: out - the report to print to
     * Returns: NONE
     * Side Effects: NONE - function is constant
     */
-    virtual void printPayInformationReport() const {
+    virtual void printPayInformationReport(ReportWriter &out) const {
         // print employee position, name, pay rate, hours worked, and weekly pay
-        cout << "Position: " << position << endl;
-        cout<< "Name: ";
-        personalInfo.getName()->print(true, ',');
-        cout << endl;
-        cout << "Pay Rate: $" << payInfo.getPayRate() << "/hour" << endl;
-        cout << "Hours Worked: " << payInfo.getHoursWorked() << endl;
-        cout << "Weekly Pay: $" << weeklyPay << endl;
+        out << "Position: " << position << '\n';
+        out << "Name: ";
+        personalInfo.getName()->print(true, ',', out);
+        out << '\n';
+        out << "Pay Rate: $" << payInfo.getPayRate() << "/hour\n";
+        out << "Hours Worked: " << payInfo.getHoursWorked() << '\n';
+        out << "Weekly Pay: $" << weeklyPay << '\n';
     }
 
     /* 
     * Purpose: To print the employee information report of an employee
-    * Parameters: NONE
+    * Parameters: out - the report to print to
     * Returns: NONE
     * Side Effects: NONE - function is constant
     */
-    virtual void printEmployeeInformationReport() const {
+    virtual void printEmployeeInformationReport(ReportWriter &out) const {
         // print employee name, position, birthday, SIN, and hourly pay rate
-        cout << "Name: ";
-        personalInfo.getName()->print(1, ',');
-        cout << endl;
-        cout << "Position: " << position << endl;
-        cout << "Birthday: ";
-        personalInfo.getDate()->print();
-        cout << endl;
-        cout << "SIN: " << personalInfo.getSIN() << endl;
-        cout << "Hourly Pay Rate: $" << payInfo.getPayRate() << "/hour" << endl;
+        out << "Name: ";
+        personalInfo.getName()->print(1, ',', out);
+        out << '\n';
+        out << "Position: " << position << '\n';
+        out << "Birthday: ";
+        personalInfo.getDate()->print(out);
+        out << '\n';
+        out << "SIN: " << personalInfo.getSIN() << '\n';
+        out << "Hourly Pay Rate: $" << payInfo.getPayRate() << "/hour\n";
     }
 
     /* 
     * Purpose: To print a cheque for an employee
-    * Parameters: NONE
+    * Parameters: out - the report to print to
     * Returns: NONE
     * Side Effects: NONE  function is constant 
     */
-    virtual void printCheque() const {
+    virtual void printCheque(ReportWriter &out) const {
         // if weekly pay is greater than $0, print an employee a cheque using the standard cheque format as specified by C*O Tam
-        if (weeklyPay > 0) {
-            cout << "Payable to ";
+        if (weeklyPay > Money()) {
+            out << "Payable to ";
             // print first name first with filler seperator because seperator is only used for when last name is printed first
-            personalInfo.getName()->print(0, 'x');
-            cout << " in the amount of $" << weeklyPay << "." << endl;
+            personalInfo.getName()->print(0, 'x', out);
+            out << " in the amount of $" << weeklyPay << ".\n";
         }
     }
 }; // Class Employee
+
+/* 
+* Purpose: To print a validation issue of an employee as an error message
+* Parameters: out - the stream to print to
+*             employee - the employee the issue belongs to
+*             rule - the check that failed
+*             value - the value that was replaced, in micros for money and hundredths for hours
+* Returns: NONE
+* Side Effects: the error message is printed to out
+*/
+void printValidationIssue(ostream &out, const Employee &employee, ValidationRule rule, long long value) {
+    out << "ERROR: " << employee.getPosition() << " ";
+    // print name with first name first and use a random character because the seperator perameter
+    // of print is only used when last name is first
+    employee.getPersonalInfo()->getName()->print(false, 'x', out);
+    switch (rule) {
+        case PAY_RATE_INVALID:
+            out << " is earning $" << Money::fromMicros(value) << " per hour. Pay rate will be set to $"
+                << PayInfo::minimumWage << " per hour." << '\n';
+            break;
+        case HOURS_INVALID:
+            out << " has worked " << Hours::fromHundredths(value) << " hours. Hours will be set to 0." << '\n';
+            break;
+        case HOURS_OVER_LIMIT:
+            out << " has worked " << Hours::fromHundredths(value)
+                << " hours which is greater than the legal limit. Hours will be set to 0." << '\n';
+            break;
+        case SALES_NEGATIVE:
+            out << " has $" << Money::fromMicros(value) << " in sales. Sales will be set to $0." << '\n';
+            break;
+    }
+}
+
+void Employee::reportIssue(ValidationRule rule, long long value) const {
+    ValidationLog::Scope *scope = ValidationLog::Scope::getCurrent();
+    if (scope != nullptr) {
+        scope->record(rule, value);
+    } else {
+        printValidationIssue(cout, *this, rule, value);
+        cout.flush();
+    }
+}
 // set maximum company wage to $100 as specified by the C*O
-const double Employee::maximumCompanyWage = 100;
+const Money Employee::maximumCompanyWage = Money::fromDollars(100);
 
 /* 
 * Class: SalaryBasedEmploye
@@ -464,7 +1565,7 @@ class SalaryBasedEmployee : public Employee {
 private:
     // a class variable for the standard number of hours per week
     // a salary based employee has included in their weekly pay
-    static const double hoursForSalary;
+    static const Hours hoursForSalary;
 public:
     /* 
     * Purpose: To construct/initialize a SalaryBasedEmployee object with values for the member variables passed into the constructor
@@ -483,7 +1584,7 @@ public:
     *               Employee::weeklyPay to the value calculated by other methods of SalaryBasedEmployee.
     *               Employee object is constructed
     */
-    SalaryBasedEmployee(string position, string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked) :
+    SalaryBasedEmployee(string_view position, string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
                         Employee(position, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked) {
         // call calcWeeklyPay when an object is constructed because the calcWeeklyPay called by methods in employees constructor
         // will not use inheritence as calcWeeklyPay in SalaryBasedEmployee will not exist when the Employee object is constructed
@@ -500,11 +1601,11 @@ protected:
     virtual void calcWeeklyPay() {
         // the weekly pay of a salary based employee is their pay rate
         // multiplied by the number of hours in a week they are paid for working
-        setWeeklyPay(hoursForSalary * getPayInfo()->getPayRate());
+        setWeeklyPay(getPayInfo()->getPayRate().times(hoursForSalary));
     }
 }; // Class SalaryBasedEmployee
 // set the hours a salary based employee is paid for as part of their salary
-const double SalaryBasedEmployee::hoursForSalary = STANDARD_WEEKLY_HOURS;
+const Hours SalaryBasedEmployee::hoursForSalary = STANDARD_WEEKLY_HOURS;
 
 /* 
 * Class: Manager
@@ -529,7 +1630,7 @@ public:
     * Returns: Not Applicable
     * Side Effects: SalaryBasedEmployee object is constructed
     */
-    Manager(string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked) :
+    Manager(string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
             SalaryBasedEmployee(managerPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked) {}
 }; // Class Manager
 
@@ -556,7 +1657,7 @@ public:
     * Returns: Not Applicable
     * Side Effects: SalaryBasedEmployee object is constructed
     */
-    Accountant(string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked) :
+    Accountant(string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
             SalaryBasedEmployee(accountantPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked) {}
 }; // Class Accountant
 
@@ -570,11 +1671,11 @@ class HourlyBasedEmployee : public Employee {
 private:
     // member variables for an hourly based employees normal pay (pay without overtime),
     // hours for overtime (hours worked before overtime applies), overtime (pay earned from overtime),
-    // and overtimeMultiplier (pay increase for working overtime).
-    double normalPay;
-    double hoursForOvertime;
-    double overtime;
-    double overtimeMultiplier;
+    // and overtimeMultiplier (pay increase for working overtime, in percent).
+    Money normalPay;
+    Hours hoursForOvertime;
+    Money overtime;
+    int overtimeMultiplier;
 
 public:
     /* 
@@ -590,13 +1691,13 @@ public:
     *             payRate - the employees hourly pay rate
     *             hoursWorked - the number of hours the employee worked in a week
     *             hoursForOvertime - the number of hours an hourly based employee must work to start earning overtime
-    *             overtimeMultiplier - the pay multiplier for an hourly based employee when they are earning overtime
+    *             overtimeMultiplier - the pay multiplier (in percent) for an hourly based employee when they are earning overtime
     * Returns: Not Applicable
     * Side Effects: setHoursWorked is called when an object is constructed which sets some member variables
     *               of Employee. Employee object is also constructed and hoursForOvertime and overtimeMultiplier variables
     *               are set in the initializers list using the values passed into the constructor
     */
-    HourlyBasedEmployee(string position, string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked, double hoursForOvertime, double overtimeMultiplier) :
+    HourlyBasedEmployee(string_view position, string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked, Hours hoursForOvertime, int overtimeMultiplier) :
                         Employee(position, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked), hoursForOvertime(hoursForOvertime), overtimeMultiplier(overtimeMultiplier) {
         // call setHoursWorked upon construction of an HourlyBasedEmployee object to work around constructor virtualness limitation
         setHoursWorked(hoursWorked);
@@ -626,14 +1727,12 @@ public:
     * Returns: NONE
     * Side Effects: Employee::hoursWorked is set by the method, and methods it calls for further validation
     */
-    virtual void setHoursWorked(double hoursWorked) {
+    virtual void setHoursWorked(Hours hoursWorked) {
         // if hourly based employee worked over 60 hours
-        // print an error message and set hours to 0
-        if (hoursWorked > 60) {
-            cout << "ERROR: " << getPosition() << " ";
-            getPersonalInfo()->getName()->print(false, 'x');
-            cout << " has worked " << hoursWorked << " hours which is greater than the legal limit. Hours will be set to 0." << endl;
-            hoursWorked = 0;
+        // report an error and set hours to 0
+        if (hoursWorked > HOURLY_HOURS_LIMIT) {
+            reportIssue(HOURS_OVER_LIMIT, hoursWorked.getHundredths());
+            hoursWorked = Hours();
         }
         // set hours worked to value passed in to method
         Employee::setHoursWorked(hoursWorked);
@@ -648,17 +1747,17 @@ private:
     */
     virtual void calcOvertime() {
         // variable for number of hours worked overtime
-        double overtimeHours = 0;
+        Hours overtimeHours;
         // variable for the difference between an employees hours worked and the hours they need to have worked to get overtime pay
-        double tmpOvertime = getPayInfo()->getHoursWorked() - hoursForOvertime;
+        Hours tmpOvertime = getPayInfo()->getHoursWorked() - hoursForOvertime;
         // if they have worked greater than the amount of overtime hours needed, 
         // set overtimeHours to the number of hours they worked overtime
-        if (tmpOvertime > 0) {
+        if (tmpOvertime > Hours()) {
             overtimeHours = tmpOvertime;
         }
         // overtime is equal to the product of the number of hours worked overtime and
         // the employees pay rate times their overtime multiplier
-        overtime = overtimeHours * (getPayInfo()->getPayRate() * overtimeMultiplier);
+        overtime = getPayInfo()->getPayRate().timesPercent(overtimeMultiplier).times(overtimeHours);
     }
 
     /* 
@@ -670,7 +1769,7 @@ private:
     virtual void calcNormalPay() {
         // variable for the number of hours an employee worked while not being paid overtime
         // set to the total number of hours they have worked to start
-        double hoursWithoutOvertime = getPayInfo()->getHoursWorked();;
+        Hours hoursWithoutOvertime = getPayInfo()->getHoursWorked();
         // if the employee has worked greater than or equal to the number of hours than needed to get overtime,
         // the number of hours they worked without overtime is equal to the minimum
         // number of hours needed to receive overtime. Ie if they get paid overtime after
@@ -680,27 +1779,27 @@ private:
         }
         // normal pay equals the number of hours worked without overtime times their
         // pay rate
-        normalPay = hoursWithoutOvertime * getPayInfo()->getPayRate();
+        normalPay = getPayInfo()->getPayRate().times(hoursWithoutOvertime);
     }
 
 public:
     /* 
     * Purpose: To print the pay information report of an hourly based employee
-    * Parameters: NONE
+    * Parameters: out - the report to print to
     * Returns: NONE
     * Side Effects: NONE - function is constant
     */
-    virtual void printPayInformationReport() const {
+    virtual void printPayInformationReport(ReportWriter &out) const {
         // get Employee to print the information from the pay report that is common among all employee types
-        Employee::printPayInformationReport();
+        Employee::printPayInformationReport(out);
         // if normal pay is greater than 0, print the pay breakdown. One can only earn overtime
         // if working over a certain number of hours but because normal pay is the amount of 
         // pay earned before overtime, it is impossible to have overtime pay if normal pay is 0.
-        if (normalPay > 0) {
+        if (normalPay > Money()) {
             // print the normal and overtime pay breakdown, using a tab (\t) for spacing to show
             // that they make up the weekly pay
-            cout << "\tNormal Pay: $" << normalPay << endl;
-            cout << "\tOvertime: $" << overtime << endl;
+            out << "\tNormal Pay: $" << normalPay << '\n';
+            out << "\tOvertime: $" << overtime << '\n';
         }
     }
 
@@ -730,8 +1829,8 @@ public:
     * Side Effects: HourlyBasedEmployee object is constructed with unique values for secretary being 40 for hours to earn overtime
     *               and 1.5 for overtime multiplier
     */
-    Secretary(string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked) :
-            HourlyBasedEmployee(secretaryPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked, 40, 1.5) {}
+    Secretary(string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
+            HourlyBasedEmployee(secretaryPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked, SECRETARY_OVERTIME_HOURS, SECRETARY_OVERTIME_MULTIPLIER) {}
 }; // Class Secretary
 
 /* 
@@ -758,8 +1857,8 @@ public:
     * Side Effects: HourlyBasedEmployee object is constructed with unique values for secretary being 44 for hours to earn overtime
     *               and 2 for overtime multiplier
     */
-    HumanResourcePerson(string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked) :
-            HourlyBasedEmployee(HRPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked, 44, 2) {}
+    HumanResourcePerson(string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
+            HourlyBasedEmployee(HRPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked, HR_OVERTIME_HOURS, HR_OVERTIME_MULTIPLIER) {}
 }; // Class HumanResourcePerson
 
 /* 
@@ -770,11 +1869,11 @@ public:
 */
 class Salesperson : public Employee {
 private:
-    // member variables for a Salesperson sales, normal pay, commission, and commission rate
-    double sales;
-    double normalPay;
-    double commission;
-    double commissionRate;
+    // member variables for a Salesperson sales, normal pay, commission, and commission rate (in basis points)
+    Money sales;
+    Money normalPay;
+    Money commission;
+    int commissionRate;
 
 public:
     /* 
@@ -790,20 +1889,23 @@ public:
     *             payRate - the employees hourly pay rate
     *             hoursWorked - the number of hours the employee worked in a week
     *             sales - the total amount ($) of sales a salesperson had in the week
-    *             commissionRate - the percentage of sales the salesperson makes in commission
+    *             commissionRate - the percentage of sales the salesperson makes in commission, in basis points
     * Returns: Not Applicable
     * Side Effects: setSales is called when an object is constructed which sets the member variable
     *               sales. calcWeeklyPay is called because due to limitations of virtualness in constructors,
     *               Salesperson::calcWeeklyPay does not exist until the Salesperson object is created after if
     *               constructs its parent.
     */
-    Salesperson(string position, string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked, double sales, double commissionRate):
+    Salesperson(string_view position, string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked, Money sales, int commissionRate):
                 Employee(position, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked), commissionRate(commissionRate) {
         // set sales and calculate salespersons weekly pay when creating a Saleperson object
         setSales(sales);
         calcWeeklyPay();
     }
 
+    // get methods
+    virtual Money getSales() const {return sales;}
+
 protected:
     /* 
     * Purpose: To calculate the weekly pay of a Salesperson
@@ -831,7 +1933,7 @@ private:
     */
     virtual void calcCommission() {
         // commission equals sales times the commission rate of the salesperson
-        commission = sales * commissionRate;
+        commission = sales.timesBasisPoints(commissionRate);
     }
 
     /* 
@@ -842,7 +1944,7 @@ private:
     */
     virtual void calcNormalPay() {
         // set paidHoursWorked to the amount of hours the salesperson worked
-        double paidHoursWorked = getPayInfo()->getHoursWorked();
+        Hours paidHoursWorked = getPayInfo()->getHoursWorked();
         // if salesperson worked greater than or equal to the standard weekly hours they are paid for
         // set the number of hours they are paid for to this maximum value 
         if (getPayInfo()->getHoursWorked() >= STANDARD_WEEKLY_HOURS) {
@@ -850,7 +1952,7 @@ private:
         }
         // normal pay is equal to the number of paid hours worked times the 
         // salespersons pay rate
-        normalPay = paidHoursWorked * getPayInfo()->getPayRate();
+        normalPay = getPayInfo()->getPayRate().times(paidHoursWorked);
     }
 
 public: 
@@ -858,35 +1960,33 @@ public:
     * Purpose: To set the sales of a salesperson
     * Parameters: sales - the amount of sales ($) a salesperson had in a week
     * Returns: NONE
-    * Side Effects: sales member variable is modified
-    */
-    virtual void setSales(double sales) {
-        // if sales is less than $0, print an error message and set to 0
-        if (sales < 0) {
-            cout << "ERROR: " << getPosition() << " ";
-            // print name with first name first and use a random character because the seperator perameter
-            // of print is only used when last name is first
-            getPersonalInfo()->getName()->print(false, 'x');
-            cout << " has $" << sales << " in sales. Sales will be set to $0." << endl;
-            this->sales = 0;
+    * Side Effects: sales member variable is modified, sales are rounded to the nearest cent
+    */
+    virtual void setSales(Money sales) {
+        // if sales is less than $0, report an error and set to 0
+        if (sales < Money()) {
+            reportIssue(SALES_NEGATIVE, sales.getMicros());
+            this->sales = Money();
         // set sales using the value passed into the method
         } else {
-            this->sales = sales;
+            this->sales = sales.roundedToCents();
         }
         // calculate commission on the new sales amount
         calcCommission();
+        // calculate the salespersons weekly pay from scratch as the commission has changed
+        calcWeeklyPay();
     }
 
     /* 
     * Purpose: To print the pay information report of a salesperson
-    * Parameters: NONE
+    * Parameters: out - the report to print to
     * Returns: NONE
     * Side Effects: NONE - function is constant
     */
-    virtual void printPayInformationReport() const {
+    virtual void printPayInformationReport(ReportWriter &out) const {
         // let Employee print the information in the pay information report 
         // that is common among all employee types
-        Employee::printPayInformationReport();
+        Employee::printPayInformationReport(out);
         // print normal pay and commission breakdown using tabs
         // to make it clear that they are the components of weekly pay
         // which is printed last by the previous method call
@@ -895,8 +1995,8 @@ public:
         // (ie if a salesperson sends a contract one week but it is signed 
         // and the sale is completed the next week when hours worked is at 0 for the week,
         // the salesperson still would make commission and so the breakdown is printed)
-        cout << "\tNormal Pay: $" << normalPay << endl;
-        cout << "\tCommision: $" << commission << endl;
+        out << "\tNormal Pay: $" << normalPay << '\n';
+        out << "\tCommision: $" << commission << '\n';
     }
 
     /* 
@@ -908,7 +2008,7 @@ public:
     */
     virtual void reset() {
         // set sales to 0 for the new week
-        setSales(0);
+        setSales(Money());
         // call Employee::reset() to reset the salespersons hours worked and consequently their weekly pay
         Employee::reset();
     }
@@ -939,7 +2039,7 @@ public:
     * Returns: Not Applicable
     * Side Effects: Salesperson object is constructed with the unique commission rate of a junior saleperson
     */
-    JrSalesperson(string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked, double sales):
+    JrSalesperson(string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked, Money sales):
                   Salesperson(juniorSalesPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked, sales, JUNIOR_COMMISSION_RATE) {}
 }; // Class JRSalesperson
 
@@ -967,138 +2067,3630 @@ public:
     * Returns: Not Applicable
     * Side Effects: Salesperson object is constructed with the unique commission rate of a senior saleperson
     */
-    SrSalesperson(string firstName, string lastName, string SIN, string birthMonth, int birthDay, int birthYear, double payRate, double hoursWorked, double sales):
+    SrSalesperson(string_view firstName, string_view lastName, string_view SIN, string_view birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked, Money sales):
                   Salesperson(seniorSalesPos, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked, sales, SENIOR_COMMISSION_RATE) {}
 }; // Class SRSalesperson
 
-int main() {
-    // variables to store the information read in from the file
-    string junk;
-    string filename;
-    string position;
-    string firstName;
-    string lastName;
-    string SIN;
-    string birthMonth;
-    int birthDay;
-    int birthYear;
-    double payRate;
-    double hoursWorked;
-    int salesMade;
-    // create pointer to employee array
-    Employee *employees[MAX_EMPLOYEES];
-    int numEmployees = 0;
-    int employeeNumber = 0;
-    double totalWeeklyPay;
-    ifstream inputFile; // C++ object that represents a file
-
-    // set output of doubles to 2 decimal places
-    cout << std::setprecision(2) << std::fixed;
+/* 
+* Class: Arena
+* Purpose: A monotonic allocator that hands out memory from large contiguous blocks.
+           Objects created in an arena sit next to each other in memory and
+           the memory is only given back all at once when the arena is destroyed
+*/
+class Arena {
+private:
+    // the blocks allocated so far and their sizes, and the unused part of the newest block
+    vector<char *> blocks;
+    vector<size_t> blockSizes;
+    char *next;
+    size_t remaining;
 
-    // welcome message
-    cout << "Welcome to Daniel's employee HR management system!" << endl;
+public:
+    /* 
+    * Purpose: To construct/initialize an empty Arena
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE - no memory is allocated until it is needed
+    */
+    Arena() : next(nullptr), remaining(0) {}
 
-    // get the name of the data file
-    cout << "Please enter the name of the data file: ";
-    getline( cin, filename );
+    /* 
+    * Purpose: To free every block of the arena
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: all memory handed out by the arena is freed. Destructors of the objects
+    *               stored in it are NOT called, that is up to the owner of the objects
+    */
+    ~Arena() {
+        for (size_t i = 0; i < blocks.size(); i++) {
+            delete[] blocks[i];
+        }
+    }
 
-    // open the file for reading
-    inputFile.open( filename );
-    getline( inputFile, position );
+    // an arena owns its blocks so it cannot be copied
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
 
-    // process the data file to read in an employee's information, and create
-    // the appropriate employees to store within our array.
-    while (( position != "END" ) && (numEmployees < MAX_EMPLOYEES)) {
-        getline( inputFile, lastName );
-        getline( inputFile, firstName );
-        getline( inputFile, SIN );
-        getline( inputFile, birthMonth );
-        inputFile >> birthDay;
-        getline( inputFile, junk );
-        inputFile >> birthYear;
-        getline( inputFile, junk );
-        inputFile >> payRate;
-        getline( inputFile, junk );
-        inputFile >> hoursWorked;
-        getline( inputFile, junk );
-        if ( position == managerPos ) {
-            employees[numEmployees] = new Manager(firstName, lastName, SIN, birthMonth,
-                birthDay, birthYear, payRate, hoursWorked);
-        } else if ( position == accountantPos ) {
-            employees[numEmployees] = new Accountant(firstName, lastName, SIN, birthMonth,
-                birthDay, birthYear, payRate, hoursWorked);
-        } else if ( position == secretaryPos ) {
-            employees[numEmployees] = new Secretary(firstName, lastName, SIN, birthMonth,
-                birthDay, birthYear, payRate, hoursWorked);
-        } else if ( position == HRPos ) {
-            employees[numEmployees] = new HumanResourcePerson(firstName, lastName, SIN, birthMonth,
-                birthDay, birthYear, payRate, hoursWorked);
-        } else if ( position == juniorSalesPos ) {
-            inputFile >> salesMade;
-            getline( inputFile, junk );
-            employees[numEmployees] = new JrSalesperson(firstName, lastName, SIN, birthMonth,
-                birthDay, birthYear, payRate, hoursWorked, salesMade);
-        } else if ( position == seniorSalesPos ) {
-            inputFile >> salesMade;
-            getline( inputFile, junk );
-            employees[numEmployees] = new SrSalesperson(firstName, lastName, SIN, birthMonth,
-                birthDay, birthYear, payRate, hoursWorked, salesMade);
-        } else {
-            cout << "(U): Unknown employee position '" << position << "'... aborting." << endl;
-            return 99;
+    /* 
+    * Purpose: To allocate memory from the arena
+    * Parameters: size - the number of bytes needed
+    *             alignment - the alignment the memory needs
+    * Returns: a pointer to size bytes of memory with the given alignment
+    * Side Effects: a new block is allocated if the current block is too full
+    */
+    void *allocate(size_t size, size_t alignment) {
+        // number of bytes to skip to align the next free byte
+        size_t padding = (alignment - ((size_t)next % alignment)) % alignment;
+        if ((next == nullptr) || (padding + size > remaining)) {
+            // objects bigger than a block get a block of their own
+            size_t blockSize = size + alignment > ARENA_BLOCK_BYTES ? size + alignment : ARENA_BLOCK_BYTES;
+            blocks.push_back(new char[blockSize]);
+            blockSizes.push_back(blockSize);
+            next = blocks.back();
+            remaining = blockSize;
+            padding = (alignment - ((size_t)next % alignment)) % alignment;
+        }
+        void *memory = next + padding;
+        next += padding + size;
+        remaining -= padding + size;
+        return memory;
+    }
+
+    /* 
+    * Purpose: To make all the memory of the arena available again
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: every block but the first is freed and the first block is reused.
+    *               Objects stored in the arena must already be destroyed
+    */
+    void reset() {
+        for (size_t i = 1; i < blocks.size(); i++) {
+            delete[] blocks[i];
         }
-        numEmployees++;
-        getline( inputFile, position );
+        blocks.resize(blocks.empty() ? 0 : 1);
+        blockSizes.resize(blocks.size());
+        next = blocks.empty() ? nullptr : blocks[0];
+        remaining = blocks.empty() ? 0 : blockSizes[0];
     }
 
-    // counter variable to be used in for loops
-    int i = 0;
+    /* 
+    * Purpose: To construct an object in the arena
+    * Parameters: args - the arguments passed on to the constructor of the object
+    * Returns: a pointer to the new object
+    * Side Effects: memory is allocated from the arena
+    */
+    template <class Type, class... Args>
+    Type *create(Args&&... args) {
+        return new (allocate(sizeof(Type), alignof(Type))) Type(std::forward<Args>(args)...);
+    }
 
-    // add a line break before printing reports
-    cout << endl;
-    cout << "-------- Printing Pay Information Report --------" << endl;
-    // loop through employee array and print pay information report for each employee
-    for ( i = 0; i < numEmployees; i++ ) {
-        employees[i]->printPayInformationReport();
-        cout << endl;
+    /* 
+    * Purpose: To copy text into the arena
+    * Parameters: text - the text to copy
+    * Returns: a view of the copy, which lives as long as the arena memory does
+    * Side Effects: memory is allocated from the arena
+    */
+    string_view copyString(string_view text) {
+        if (text.empty()) {
+            return string_view();
+        }
+        char *copy = (char *)allocate(text.size(), 1);
+        memcpy(copy, text.data(), text.size());
+        return string_view(copy, text.size());
+    }
+}; // Class Arena
+
+/* 
+* Class: StringPool
+* Purpose: A pool that keeps one copy of each distinct string handed to it (interning),
+           for text that is shared by many employees such as month names
+*/
+class StringPool {
+private:
+    // the arena the strings are stored in, and a view of every string in the pool
+    Arena storage;
+    unordered_set<string_view> strings;
+
+public:
+    /* 
+    * Purpose: To construct/initialize an empty StringPool
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    StringPool() {}
+
+    // a pool owns its strings so it cannot be copied
+    StringPool(const StringPool &) = delete;
+    StringPool &operator=(const StringPool &) = delete;
+
+    /* 
+    * Purpose: To find the pooled copy of a string, adding it to the pool if it is not there yet
+    * Parameters: text - the string to intern
+    * Returns: a view of the pooled copy, which lives as long as the pool does
+    * Side Effects: the string is copied into the pool the first time it is seen
+    */
+    string_view intern(string_view text) {
+        auto found = strings.find(text);
+        if (found != strings.end()) {
+            return *found;
+        }
+        string_view copy = storage.copyString(text);
+        strings.insert(copy);
+        return copy;
     }
+}; // Class StringPool
+
+/* 
+* Class: Roster
+* Purpose: A class that stores every employee of a company. The roster grows
+           with the input so there is no limit on the number of employees
+           it can hold. Employees are created in the roster's arena so they
+           are packed together in memory and all freed at once with the roster
+*/
+class Roster {
+private:
+    // the arena the employees and their names live in, and pointers to each employee in the order they were created
+    Arena arena;
+    vector<Employee *> employees;
+    // text shared by many employees, kept when the roster is cleared
+    StringPool sharedStrings;
+    // running totals of the weekly pay of the employees in the roster
+    PayrollLedger ledger;
+    // number of strings copied into the arena by storeString
+    size_t copiedStrings = 0;
+    // values the employees were given that failed a check, until they are printed
+    ValidationLog validationLog;
 
-    cout << "-------- Printing Employee Information Report --------" << endl; 
-    // loop through employee array and print employee information report for each employee
-    for ( i = 0; i < numEmployees; i++ ) {
-        employees[i]->printEmployeeInformationReport();
-        cout << endl;
+public:
+    /* 
+    * Purpose: To construct/initialize a Roster with room for an expected number of employees
+    * Parameters: sizeHint - the number of employees the roster is expected to hold
+    * Returns: Not Applicable
+    * Side Effects: storage for sizeHint employees is reserved
+    */
+    Roster(size_t sizeHint = 0) {
+        reserve(sizeHint);
     }
 
-    cout << "-------- Printing Cheques --------" << endl;
-    // loop through employee array and print a cheque for each employee who earned one
-    for ( i = 0; i < numEmployees; i++ ) {
-        employees[i]->printCheque();
-        // add up total weekly company pay when printing cheques 
-        totalWeeklyPay += employees[i]->getWeeklyPay();
+    /* 
+    * Purpose: To destroy every employee the roster owns
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: every employee created in the roster is destroyed and the arena frees their memory
+    */
+    ~Roster() {
+        for (size_t i = 0; i < employees.size(); i++) {
+            employees[i]->~Employee();
+        }
     }
 
-    // start of a new week
-    for ( i = 0; i < numEmployees; i++ ) {
-        employees[i]->reset();
+    // a roster owns its employees so it cannot be copied
+    Roster(const Roster &) = delete;
+    Roster &operator=(const Roster &) = delete;
+
+    // get methods
+    size_t size() const {return employees.size();}
+    PayrollLedger &getLedger() {return ledger;}
+    const PayrollLedger &getLedger() const {return ledger;}
+    ValidationLog &getValidationLog() {return validationLog;}
+    size_t getCopiedStrings() const {return copiedStrings;}
+    size_t capacity() const {return employees.capacity();}
+    Employee *operator[](size_t i) const {return employees[i];}
+
+    /* 
+    * Purpose: To reserve storage for an expected number of employees so adding them does not reallocate
+    * Parameters: sizeHint - the number of employees the roster is expected to hold
+    * Returns: NONE
+    * Side Effects: the roster storage may be reallocated
+    */
+    void reserve(size_t sizeHint) {
+        employees.reserve(sizeHint);
     }
 
-    // for ( i = 0; i < numEmployees; i++ ) {
-    //     employees[i]->printPayInformationReport();
-    //     cout << endl;
-    // }
+    /* 
+    * Purpose: To remove every employee from the roster
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: every employee is destroyed and the arena memory is reused for the next employees.
+    *               Text stored with storeString is freed, interned text is kept
+    */
+    void clear() {
+        for (size_t i = 0; i < employees.size(); i++) {
+            employees[i]->~Employee();
+        }
+        employees.clear();
+        arena.reset();
+    }
 
-    // line break for spacing
-    cout << endl;
-    // print company summary with number of employees and total weekly pay out.
-    cout << "-------- Company Summary --------" << endl;
-    cout << "Number of Employees: " << numEmployees << endl;
-    cout << "Total Weekly Pay: $" << totalWeeklyPay << endl; 
-    
-    cout << endl;
-    
-    // closing message
-    cout << "Thank you for using this employee HR management system!" << endl;
+    /* 
+    * Purpose: To create an employee at the end of the roster
+    * Parameters: args - the arguments passed on to the constructor of the employee
+    * Returns: a pointer to the new employee
+    * Side Effects: the employee is constructed in the arena and will be destroyed with the roster
+    */
+    template <class EmployeeType, class... Args>
+    EmployeeType *create(Args&&... args) {
+        EmployeeType *employee = arena.create<EmployeeType>(std::forward<Args>(args)...);
+        employees.push_back(employee);
+        return employee;
+    }
 
-    return 0;
+    /* 
+    * Purpose: To store text owned by one employee, such as their name, in the roster's arena
+    * Parameters: text - the text to store
+    * Returns: a view of the stored copy, which lives until the roster is cleared or destroyed
+    * Side Effects: the text is copied into the arena and counted in copiedStrings
+    */
+    string_view storeString(string_view text) {
+        copiedStrings++;
+        return arena.copyString(text);
+    }
+
+    /* 
+    * Purpose: To store text shared by many employees, such as a month, only once
+    * Parameters: text - the text to store
+    * Returns: a view of the interned copy, which lives as long as the roster does
+    * Side Effects: the text is copied into the roster's string pool the first time it is seen
+    */
+    string_view internString(string_view text) {
+        return sharedStrings.intern(text);
+    }
+
+    /* 
+    * Purpose: To estimate how many employees are stored in an input file from its size
+    * Parameters: bytes - the size of the employee data file in bytes
+    * Returns: the estimated number of employees in the file
+    * Side Effects: NONE
+    */
+    static size_t estimateSize(size_t bytes) {
+        return bytes > 0 ? bytes / AVERAGE_RECORD_BYTES + 1 : 0;
+    }
+}; // Class Roster
+
+/* 
+* Class: EmployeeRecord
+* Purpose: The fields of one employee as read from an employee data file. The text
+           fields are views into the file contents so they are only valid while the
+           file is open
+*/
+struct EmployeeRecord {
+    string_view position;
+    string_view lastName;
+    string_view firstName;
+    string_view SIN;
+    string_view birthMonth;
+    int birthDay;
+    int birthYear;
+    Money payRate;
+    Hours hoursWorked;
+    // only read for salespeople
+    Money sales;
+};
+
+// the ways employees are paid, see SalaryBasedEmployee, HourlyBasedEmployee and Salesperson
+enum PayPolicy {SALARY_BASED, HOURLY_BASED, SALES_BASED};
+
+/* 
+* Class: PositionDescriptor
+* Purpose: Everything about one position at the company that is needed to read, create and
+           pay an employee holding it. Every position is described once in the POSITIONS table,
+           so a new position is added by writing its class and adding a row to the table
+*/
+struct PositionDescriptor {
+    PositionTag tag;
+    // the official title of the position, as written in employee data files
+    const char *title;
+    // whether records of the position have a sales line after the hours worked
+    bool hasSales;
+    // how the position is paid, and the overtime or commission terms of that pay policy
+    PayPolicy payPolicy;
+    Hours overtimeHours;
+    int overtimeMultiplier;
+    int commissionRate;
+    // creates an employee holding the position at the end of a roster
+    Employee *(*create)(Roster &roster, const EmployeeRecord &record);
+};
+
+/* 
+* Purpose: To create an employee of one position class from an employee record, used as the
+*          create function of a PositionDescriptor
+* Parameters: roster - the roster to add the employee to
+*             record - the fields of the employee
+* Returns: a pointer to the new employee
+* Side Effects: the employee is created in the roster
+*/
+template <class EmployeeType>
+Employee *createPosition(Roster &roster, const EmployeeRecord &record) {
+    // names and SINs belong to one employee, months are shared by many so they are interned
+    string_view firstName = roster.storeString(record.firstName);
+    string_view lastName = roster.storeString(record.lastName);
+    string_view SIN = roster.storeString(record.SIN);
+    string_view birthMonth = roster.internString(record.birthMonth);
+    // only salespeople take their sales
+    if constexpr (is_base_of<Salesperson, EmployeeType>::value) {
+        return roster.create<EmployeeType>(firstName, lastName, SIN, birthMonth,
+            record.birthDay, record.birthYear, record.payRate, record.hoursWorked, record.sales);
+    } else {
+        return roster.create<EmployeeType>(firstName, lastName, SIN, birthMonth,
+            record.birthDay, record.birthYear, record.payRate, record.hoursWorked);
+    }
+}
+
+// every position at the company, in PositionTag order
+constexpr PositionDescriptor POSITIONS[NUM_POSITIONS] = {
+    {MANAGER, managerPos, false, SALARY_BASED, Hours(), 0, 0, createPosition<Manager>},
+    {ACCOUNTANT, accountantPos, false, SALARY_BASED, Hours(), 0, 0, createPosition<Accountant>},
+    {SECRETARY, secretaryPos, false, HOURLY_BASED, SECRETARY_OVERTIME_HOURS, SECRETARY_OVERTIME_MULTIPLIER, 0, createPosition<Secretary>},
+    {HUMAN_RESOURCE, HRPos, false, HOURLY_BASED, HR_OVERTIME_HOURS, HR_OVERTIME_MULTIPLIER, 0, createPosition<HumanResourcePerson>},
+    {JUNIOR_SALES, juniorSalesPos, true, SALES_BASED, Hours(), 0, JUNIOR_COMMISSION_RATE, createPosition<JrSalesperson>},
+    {SENIOR_SALES, seniorSalesPos, true, SALES_BASED, Hours(), 0, SENIOR_COMMISSION_RATE, createPosition<SrSalesperson>},
+};
+
+// number of slots in the position hash table, a power of two larger than the number of positions
+const uint32_t POSITION_HASH_SLOTS = 16;
+
+/* 
+* Purpose: To hash a position title into a slot of the position hash table
+* Parameters: title - the title to hash
+*             seed - the seed of the hash, chosen so no two positions share a slot
+* Returns: the slot of the title
+* Side Effects: NONE
+*/
+constexpr uint32_t hashPosition(string_view title, uint32_t seed) {
+    uint32_t hash = seed;
+    for (size_t i = 0; i < title.size(); i++) {
+        hash = (hash ^ (unsigned char)title[i]) * 16777619u;
+    }
+    return (hash ^ (hash >> 16)) % POSITION_HASH_SLOTS;
+}
+
+/* 
+* Class: PositionHashTable
+* Purpose: A perfect hash table from position titles to position tags. The table is built
+           at compile time by trying seeds until every position lands in its own slot
+*/
+struct PositionHashTable {
+    bool found;
+    uint32_t seed;
+    PositionTag slots[POSITION_HASH_SLOTS];
+};
+
+/* 
+* Purpose: To build the position hash table from the POSITIONS table
+* Parameters: NONE
+* Returns: the table, found is false if no seed gives every position its own slot
+* Side Effects: NONE
+*/
+constexpr PositionHashTable buildPositionHashTable() {
+    PositionHashTable table = {false, 0, {}};
+    for (uint32_t seed = 0; (seed < 1000) && !table.found; seed++) {
+        table.found = true;
+        table.seed = seed;
+        for (uint32_t slot = 0; slot < POSITION_HASH_SLOTS; slot++) {
+            table.slots[slot] = NUM_POSITIONS;
+        }
+        for (int p = 0; p < NUM_POSITIONS; p++) {
+            uint32_t slot = hashPosition(POSITIONS[p].title, seed);
+            if (table.slots[slot] != NUM_POSITIONS) {
+                table.found = false;
+            }
+            table.slots[slot] = (PositionTag)p;
+        }
+    }
+    return table;
+}
+
+/* 
+* Purpose: To check that every row of the POSITIONS table is at the index of its tag
+* Parameters: NONE
+* Returns: true if every row is in place
+* Side Effects: NONE
+*/
+constexpr bool positionsInTagOrder() {
+    for (int p = 0; p < NUM_POSITIONS; p++) {
+        if (POSITIONS[p].tag != p) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr PositionHashTable POSITION_HASH_TABLE = buildPositionHashTable();
+static_assert(POSITION_HASH_TABLE.found, "no seed gives every position its own hash slot");
+static_assert(positionsInTagOrder(), "the POSITIONS table must be in PositionTag order");
+
+/* 
+* Purpose: To find the description of a position from its title. The cost is the same
+*          no matter how many positions there are
+* Parameters: title - the official title of the position
+* Returns: the description of the position, nullptr if it is not a position at the company
+* Side Effects: NONE
+*/
+inline const PositionDescriptor *findPosition(string_view title) {
+    PositionTag tag = POSITION_HASH_TABLE.slots[hashPosition(title, POSITION_HASH_TABLE.seed)];
+    if ((tag != NUM_POSITIONS) && (title == POSITIONS[tag].title)) {
+        return &POSITIONS[tag];
+    }
+    return nullptr;
+}
+
+/* 
+* Class: RosterPolicy
+* Purpose: A class that holds the optional staffing limits of a company (such as
+           MAX_MANAGERS) and reports any roster that breaks them. The limits
+           never stop employees from being stored, they are only checked
+*/
+class RosterPolicy {
+private:
+    // a staffing limit on the number of employees holding one or more positions
+    struct Limit {
+        string name;
+        vector<PositionTag> positions;
+        size_t maximum;
+    };
+    // the limits that are checked, and the limit on the total number of employees (0 for none)
+    vector<Limit> limits;
+    size_t maximumEmployees;
+
+public:
+    /* 
+    * Purpose: To construct/initialize a RosterPolicy with no limits
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    RosterPolicy() : maximumEmployees(0) {}
+
+    /* 
+    * Purpose: To create the staffing policy set by the C*O using the MAX_* constants
+    * Parameters: NONE
+    * Returns: a RosterPolicy holding the company staffing limits
+    * Side Effects: NONE
+    */
+    static RosterPolicy companyDefault() {
+        RosterPolicy policy;
+        policy.addLimit("manager", {MANAGER}, MAX_MANAGERS);
+        policy.addLimit("accountant", {ACCOUNTANT}, MAX_ACCOUNTANTS);
+        policy.addLimit("secretary", {SECRETARY}, MAX_SECRETARIES);
+        policy.addLimit("human resource", {HUMAN_RESOURCE}, MAX_HR);
+        policy.addLimit("salesperson", {JUNIOR_SALES, SENIOR_SALES}, MAX_SALESPEOPLE);
+        policy.setMaximumEmployees(MAX_EMPLOYEES);
+        return policy;
+    }
+
+    /* 
+    * Purpose: To add a limit on the number of employees holding a group of positions
+    * Parameters: name - the name used for the limit when a violation is reported
+    *             positions - the positions counted towards the limit
+    *             maximum - the maximum number of employees allowed in those positions
+    * Returns: NONE
+    * Side Effects: the limit is stored in the policy
+    */
+    void addLimit(const string &name, const vector<PositionTag> &positions, size_t maximum) {
+        limits.push_back({name, positions, maximum});
+    }
+
+    /* 
+    * Purpose: To set the limit on the total number of employees
+    * Parameters: maximumEmployees - the maximum number of employees, 0 for no limit
+    * Returns: NONE
+    * Side Effects: maximumEmployees member variable is set
+    */
+    void setMaximumEmployees(size_t maximumEmployees) {
+        this->maximumEmployees = maximumEmployees;
+    }
+
+    /* 
+    * Purpose: To count the employees of a roster towards each limit of the policy. A roster
+    *          read in parts can be counted one part at a time
+    * Parameters: roster - the employees to count
+    *             counts - the count for each limit, it is created if it is empty and added to if it is not.
+    *                      The last count is the total number of employees
+    * Returns: NONE
+    * Side Effects: counts is updated
+    */
+    void tally(const Roster &roster, vector<size_t> &counts) const {
+        counts.resize(limits.size() + 1, 0);
+        for (size_t i = 0; i < roster.size(); i++) {
+            const PositionDescriptor *position = findPosition(roster[i]->getPosition());
+            if (position == nullptr) {
+                continue;
+            }
+            for (size_t j = 0; j < limits.size(); j++) {
+                for (size_t k = 0; k < limits[j].positions.size(); k++) {
+                    if (limits[j].positions[k] == position->tag) {
+                        counts[j]++;
+                    }
+                }
+            }
+        }
+        counts[limits.size()] += roster.size();
+    }
+
+    /* 
+    * Purpose: To check counts made by tally against the policy
+    * Parameters: counts - the counts for each limit made by tally
+    * Returns: a message for every limit the counts break, empty if they break none
+    * Side Effects: NONE
+    */
+    vector<string> check(const vector<size_t> &counts) const {
+        vector<string> violations;
+        for (size_t j = 0; (j < limits.size()) && (j < counts.size()); j++) {
+            if (counts[j] > limits[j].maximum) {
+                violations.push_back("roster has " + to_string(counts[j]) + " " + limits[j].name + " employees but the limit is "
+                                     + to_string(limits[j].maximum) + ".");
+            }
+        }
+        size_t total = counts.size() > limits.size() ? counts[limits.size()] : 0;
+        if ((maximumEmployees > 0) && (total > maximumEmployees)) {
+            violations.push_back("roster has " + to_string(total) + " employees but the limit is "
+                                 + to_string(maximumEmployees) + ".");
+        }
+        return violations;
+    }
+
+    /* 
+    * Purpose: To check a roster against the policy
+    * Parameters: roster - the roster to check
+    * Returns: a message for every limit the roster breaks, empty if it breaks none
+    * Side Effects: NONE
+    */
+    vector<string> check(const Roster &roster) const {
+        vector<size_t> counts;
+        tally(roster, counts);
+        return check(counts);
+    }
+}; // Class RosterPolicy
+
+/* 
+* Class: SinIndex
+* Purpose: An open addressing hash table from packed SINs (see parseSIN) to the employee
+           holding each SIN, so employees can be found by SIN without scanning the roster.
+           When several employees share a SIN the index keeps the first of them, which is
+           how duplicate SINs are found. A whole roster is indexed on multiple threads
+           with build, or employees can be added one at a time with insert
+*/
+class SinIndex {
+private:
+    // the packed SIN and employee of a bucket, NO_SIN marks an empty bucket. They are kept
+    // together so a lookup touches one cache line, and are atomic so build can fill buckets
+    // from several threads at once
+    struct Bucket {
+        atomic<uint64_t> key;
+        atomic<uint64_t> slot;
+    };
+    vector<Bucket> buckets;
+    // number of buckets minus one (the number of buckets is a power of two), and number of SINs held
+    size_t mask;
+    size_t count;
+
+public:
+    // returned by find when a SIN is not in the index
+    static const size_t NOT_FOUND = (size_t)-1;
+
+    /* 
+    * Purpose: To construct/initialize an empty SinIndex
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    SinIndex() : mask(0), count(0) {
+        allocate(0);
+    }
+
+    // get methods
+    size_t size() const {return count;}
+
+    /* 
+    * Purpose: To index every employee of a roster, replacing anything already in the index. The
+    *          roster is split into chunks of PAYROLL_CHUNK_SIZE employees which the threads take turns
+    *          adding, buckets are claimed with compare and swap so no locks are needed. Which employee a SIN maps to
+    *          does not depend on the order the threads run in
+    * Parameters: roster - the roster to index
+    *             threads - the number of threads to use, 0 to use every core
+    * Returns: NONE
+    * Side Effects: the index is rebuilt
+    */
+    void build(const Roster &roster, unsigned threads) {
+        allocate(roster.size());
+        // the roster is indexed in chunks, so threads are only started for large rosters
+        size_t numChunks = (roster.size() + PAYROLL_CHUNK_SIZE - 1) / PAYROLL_CHUNK_SIZE;
+        atomic<size_t> added(0);
+        runOnThreads(threads, numChunks, [&](size_t chunk) {
+            size_t begin = chunk * PAYROLL_CHUNK_SIZE;
+            size_t end = begin + PAYROLL_CHUNK_SIZE < roster.size() ? begin + PAYROLL_CHUNK_SIZE : roster.size();
+            size_t newSINs = 0;
+            for (size_t i = begin; i < end; i++) {
+                uint64_t key = roster[i]->getPersonalInfo()->getPackedSIN();
+                if ((key != NO_SIN) && claim(key, i)) {
+                    newSINs++;
+                }
+            }
+            added.fetch_add(newSINs);
+        });
+        count = added.load();
+    }
+
+    /* 
+    * Purpose: To add one employee to the index
+    * Parameters: key - the packed SIN of the employee
+    *             slot - the employee, such as their index in the roster
+    * Returns: the employee the SIN maps to, slot if the SIN was new or NOT_FOUND if key is NO_SIN
+    * Side Effects: the index grows when it is half full
+    */
+    size_t insert(uint64_t key, size_t slot) {
+        if (key == NO_SIN) {
+            return NOT_FOUND;
+        }
+        if ((count + 1) * 2 > buckets.size()) {
+            grow();
+        }
+        if (claim(key, slot)) {
+            count++;
+        }
+        return find(key);
+    }
+
+    /* 
+    * Purpose: To find the employee holding a SIN
+    * Parameters: key - the packed SIN to find
+    * Returns: the employee the SIN maps to, NOT_FOUND if no employee has the SIN
+    * Side Effects: NONE
+    */
+    size_t find(uint64_t key) const {
+        if (key == NO_SIN) {
+            return NOT_FOUND;
+        }
+        for (size_t b = bucketOf(key); ; b = (b + 1) & mask) {
+            uint64_t current = buckets[b].key.load(memory_order_relaxed);
+            if (current == key) {
+                return buckets[b].slot.load(memory_order_relaxed);
+            } else if (current == NO_SIN) {
+                return NOT_FOUND;
+            }
+        }
+    }
+
+private:
+    /* 
+    * Purpose: To make an empty table with room for a number of SINs at no more than half full
+    * Parameters: expected - the number of SINs the table should hold
+    * Returns: NONE
+    * Side Effects: the buckets are replaced with empty ones
+    */
+    void allocate(size_t expected) {
+        size_t size = 16;
+        while (size < expected * 2) {
+            size *= 2;
+        }
+        buckets = vector<Bucket>(size);
+        for (size_t b = 0; b < size; b++) {
+            buckets[b].key.store(NO_SIN, memory_order_relaxed);
+            buckets[b].slot.store(NOT_FOUND, memory_order_relaxed);
+        }
+        mask = size - 1;
+        count = 0;
+    }
+
+    /* 
+    * Purpose: To double the number of buckets, keeping every SIN and its employee
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: the buckets are replaced
+    */
+    void grow() {
+        vector<Bucket> oldBuckets;
+        oldBuckets.swap(buckets);
+        size_t oldCount = count;
+        allocate(oldBuckets.size());
+        for (size_t b = 0; b < oldBuckets.size(); b++) {
+            uint64_t key = oldBuckets[b].key.load(memory_order_relaxed);
+            if (key != NO_SIN) {
+                claim(key, oldBuckets[b].slot.load(memory_order_relaxed));
+            }
+        }
+        count = oldCount;
+    }
+
+    /* 
+    * Purpose: To find the first bucket to look in for a SIN
+    * Parameters: key - the packed SIN
+    * Returns: the bucket
+    * Side Effects: NONE
+    */
+    size_t bucketOf(uint64_t key) const {
+        // multiplying by a large odd constant mixes every digit into the top bits
+        return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    }
+
+    /* 
+    * Purpose: To put a SIN in the table, or find the bucket it is already in, and map it to the
+    *          smallest employee slot seen for it. Safe to call from several threads at once
+    * Parameters: key - the packed SIN, which is not NO_SIN
+    *             slot - the employee holding the SIN
+    * Returns: true if the SIN was not in the table before
+    * Side Effects: a bucket may be claimed and its employee updated
+    */
+    bool claim(uint64_t key, size_t slot) {
+        bool added = false;
+        size_t b = bucketOf(key);
+        while (true) {
+            uint64_t current = buckets[b].key.load(memory_order_acquire);
+            if ((current == NO_SIN) && buckets[b].key.compare_exchange_strong(current, key)) {
+                added = true;
+                break;
+            }
+            // a failed compare and swap leaves the SIN that won the bucket in current
+            if (current == key) {
+                break;
+            }
+            b = (b + 1) & mask;
+        }
+        uint64_t seen = buckets[b].slot.load(memory_order_relaxed);
+        while ((slot < seen) && !buckets[b].slot.compare_exchange_weak(seen, slot)) {}
+        return added;
+    }
+}; // Class SinIndex
+
+/* 
+* Class: HourlyPayKernel
+* Purpose: Batch kernels that calculate normal pay, overtime and weekly pay of many hourly
+           based employees at once (see HourlyBasedEmployee::calcWeeklyPay). Pay rates are
+           whole cents, hours are hundredths of an hour and the results are Money micros, so
+           the kernels only use integer arithmetic. The AVX2 kernel handles four employees per
+           instruction using min/max instead of branches and is only used when the CPU supports
+           it, otherwise the scalar kernel is used. Both kernels give bit for bit the same results.
+           Validated pay rates (at most $100) and hours (at most a week) fit in 32 bits, which
+           the AVX2 kernel relies on for its 32 x 32 -> 64 bit multiplies
+*/
+class HourlyPayKernel {
+public:
+    /* 
+    * Purpose: To calculate the pay of hourly based employees one at a time
+    * Parameters: size - the number of employees
+    *             payRate - the pay rate of each employee in cents
+    *             hoursWorked - the hours worked by each employee in hundredths of an hour
+    *             hoursForOvertime - the number of hours (in hundredths) that must be worked to start earning overtime
+    *             overtimeMultiplier - the pay multiplier for overtime hours in percent
+    *             normalPay - filled with the normal pay of each employee in micros
+    *             overtime - filled with the overtime pay of each employee in micros
+    *             weeklyPay - filled with the weekly pay of each employee in micros
+    * Returns: NONE
+    * Side Effects: normalPay, overtime and weeklyPay are filled in
+    */
+    static void computeScalar(size_t size, const long long *payRate, const long long *hoursWorked, long long hoursForOvertime, long long overtimeMultiplier,
+                              long long *normalPay, long long *overtime, long long *weeklyPay) {
+        for (size_t r = 0; r < size; r++) {
+            long long normalHours = hoursWorked[r] >= hoursForOvertime ? hoursForOvertime : hoursWorked[r];
+            long long overtimeHours = hoursWorked[r] - hoursForOvertime > 0 ? hoursWorked[r] - hoursForOvertime : 0;
+            // cents * hundredths of an hour is in hundredths of a cent, which is 100 micros
+            normalPay[r] = normalHours * (payRate[r] * 100);
+            // cents * percent is already in hundredths of a cent per hour
+            overtime[r] = overtimeHours * (payRate[r] * overtimeMultiplier);
+            long long pay = normalPay[r] + overtime[r];
+            weeklyPay[r] = pay >= 0 ? pay : 0;
+        }
+    }
+
+#ifdef EMPLOYEE_HAVE_AVX2_KERNELS
+    /* 
+    * Purpose: To calculate the pay of hourly based employees four at a time with AVX2
+    * Parameters: see computeScalar
+    * Returns: NONE
+    * Side Effects: normalPay, overtime and weeklyPay are filled in
+    */
+    __attribute__((target("avx2")))
+    static void computeAvx2(size_t size, const long long *payRate, const long long *hoursWorked, long long hoursForOvertime, long long overtimeMultiplier,
+                            long long *normalPay, long long *overtime, long long *weeklyPay) {
+        const __m256i overtimeHoursVec = _mm256_set1_epi64x(hoursForOvertime);
+        const __m256i multiplierVec = _mm256_set1_epi64x(overtimeMultiplier);
+        const __m256i hundred = _mm256_set1_epi64x(100);
+        const __m256i zero = _mm256_setzero_si256();
+        size_t r = 0;
+        for (; r + 4 <= size; r += 4) {
+            __m256i rate = _mm256_loadu_si256((const __m256i *)(payRate + r));
+            __m256i hours = _mm256_loadu_si256((const __m256i *)(hoursWorked + r));
+            // min(hoursForOvertime, hours) and max(hours - hoursForOvertime, 0) built from 64 bit compares
+            __m256i normalHours = _mm256_blendv_epi8(overtimeHoursVec, hours, _mm256_cmpgt_epi64(overtimeHoursVec, hours));
+            __m256i overtimeHours = _mm256_sub_epi64(hours, overtimeHoursVec);
+            overtimeHours = _mm256_and_si256(overtimeHours, _mm256_cmpgt_epi64(overtimeHours, zero));
+            __m256i normal = _mm256_mul_epi32(normalHours, _mm256_mul_epi32(rate, hundred));
+            __m256i extra = _mm256_mul_epi32(overtimeHours, _mm256_mul_epi32(rate, multiplierVec));
+            __m256i pay = _mm256_add_epi64(normal, extra);
+            // weekly pay is set to 0 when it is negative
+            pay = _mm256_andnot_si256(_mm256_cmpgt_epi64(zero, pay), pay);
+            _mm256_storeu_si256((__m256i *)(normalPay + r), normal);
+            _mm256_storeu_si256((__m256i *)(overtime + r), extra);
+            _mm256_storeu_si256((__m256i *)(weeklyPay + r), pay);
+        }
+        // finish the employees left over after the last group of four
+        computeScalar(size - r, payRate + r, hoursWorked + r, hoursForOvertime, overtimeMultiplier, normalPay + r, overtime + r, weeklyPay + r);
+    }
+#endif
+
+    /* 
+    * Purpose: To check whether the CPU running the program supports the AVX2 kernel
+    * Parameters: NONE
+    * Returns: true if computeAvx2 can be used, false if it cannot
+    * Side Effects: NONE
+    */
+    static bool avx2Supported() {
+#ifdef EMPLOYEE_HAVE_AVX2_KERNELS
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    /* 
+    * Purpose: To calculate the pay of hourly based employees with the fastest kernel the CPU supports
+    * Parameters: see computeScalar
+    * Returns: NONE
+    * Side Effects: normalPay, overtime and weeklyPay are filled in
+    */
+    static void compute(size_t size, const long long *payRate, const long long *hoursWorked, long long hoursForOvertime, long long overtimeMultiplier,
+                        long long *normalPay, long long *overtime, long long *weeklyPay) {
+#ifdef EMPLOYEE_HAVE_AVX2_KERNELS
+        if (avx2Supported()) {
+            computeAvx2(size, payRate, hoursWorked, hoursForOvertime, overtimeMultiplier, normalPay, overtime, weeklyPay);
+            return;
+        }
+#endif
+        computeScalar(size, payRate, hoursWorked, hoursForOvertime, overtimeMultiplier, normalPay, overtime, weeklyPay);
+    }
+
+    /* 
+    * Purpose: To check that the vector kernel gives bit for bit the same results as the scalar kernel
+    *          on generated inputs, including hours right at, below and above the overtime threshold
+    * Parameters: employees - the number of employees to generate for each overtime policy
+    *             seed - the seed for the random number generator so a run can be repeated
+    * Returns: the number of results that did not match, 0 if the kernels agree
+    * Side Effects: NONE
+    */
+    static size_t selfCheck(size_t employees, unsigned seed) {
+        size_t mismatches = 0;
+#ifdef EMPLOYEE_HAVE_AVX2_KERNELS
+        if (!avx2Supported()) {
+            return 0;
+        }
+        mt19937 generator(seed);
+        uniform_int_distribution<long long> rates(PayInfo::minimumWage.getCents(), Employee::maximumCompanyWage.getCents());
+        uniform_int_distribution<long long> hours(0, HOURLY_HOURS_LIMIT.getHundredths());
+        const long long policies[2][2] = {{SECRETARY_OVERTIME_HOURS.getHundredths(), SECRETARY_OVERTIME_MULTIPLIER},
+                                          {HR_OVERTIME_HOURS.getHundredths(), HR_OVERTIME_MULTIPLIER}};
+        for (int p = 0; p < 2; p++) {
+            vector<long long> payRate(employees), hoursWorked(employees);
+            for (size_t r = 0; r < employees; r++) {
+                payRate[r] = rates(generator);
+                // every few employees work exactly the overtime threshold, no hours, or the legal limit
+                switch (r % 8) {
+                    case 0: hoursWorked[r] = policies[p][0]; break;
+                    case 1: hoursWorked[r] = 0; break;
+                    case 2: hoursWorked[r] = HOURLY_HOURS_LIMIT.getHundredths(); break;
+                    default: hoursWorked[r] = hours(generator); break;
+                }
+            }
+            vector<long long> scalarResults(3 * employees), vectorResults(3 * employees);
+            computeScalar(employees, payRate.data(), hoursWorked.data(), policies[p][0], policies[p][1],
+                          scalarResults.data(), scalarResults.data() + employees, scalarResults.data() + 2 * employees);
+            computeAvx2(employees, payRate.data(), hoursWorked.data(), policies[p][0], policies[p][1],
+                        vectorResults.data(), vectorResults.data() + employees, vectorResults.data() + 2 * employees);
+            for (size_t r = 0; r < 3 * employees; r++) {
+                if (scalarResults[r] != vectorResults[r]) {
+                    mismatches++;
+                }
+            }
+        }
+#else
+        (void)employees;
+        (void)seed;
+#endif
+        return mismatches;
+    }
+}; // Class HourlyPayKernel
+
+/* 
+* Class: ChunkTotal
+* Purpose: The total weekly pay of one chunk of the payroll. Each total sits on its own
+           cache line so totals written by different threads do not false share
+*/
+struct alignas(CACHE_LINE_BYTES) ChunkTotal {
+    Money total;
+};
+
+/* 
+* Class: PayrollEngine
+* Purpose: A class that calculates the weekly pay of a whole roster without going
+           through the Employee class hierarchy. The pay inputs of each position are
+           stored as parallel columns (structure of arrays) and weekly pay is calculated
+           one position at a time in tight loops with no virtual calls. The amounts
+           match the ones calculated by the Employee classes exactly, the classes stay
+           responsible for validation and printing the reports
+*/
+class PayrollEngine {
+private:
+    // the pay inputs and results of every employee holding one position. Row r of each
+    // column belongs to the employee at roster index slot[r]
+    struct PayGroup {
+        vector<size_t> slot;
+        vector<long long> payRate;      // cents
+        vector<long long> hoursWorked;  // hundredths of an hour
+        vector<long long> sales;        // cents
+        vector<long long> normalPay;    // micros
+        vector<long long> extraPay;     // micros of overtime or commission depending on the position
+        vector<long long> weeklyPay;    // micros
+    };
+    PayGroup groups[NUM_POSITIONS];
+    // the position tag of each roster index and its row in that positions group
+    vector<unsigned char> positions;
+    vector<size_t> rows;
+    // total weekly pay of the roster, valid after compute() is called
+    Money totalWeeklyPay;
+
+public:
+    /* 
+    * Purpose: To construct/initialize an empty PayrollEngine
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    PayrollEngine() {}
+
+    /* 
+    * Purpose: To copy the validated pay inputs of every employee in a roster into the engine columns
+    * Parameters: roster - the roster to load
+    * Returns: NONE
+    * Side Effects: any previously loaded roster is replaced
+    */
+    void load(const Roster &roster) {
+        for (int p = 0; p < NUM_POSITIONS; p++) {
+            groups[p] = PayGroup();
+        }
+        positions.assign(roster.size(), NUM_POSITIONS);
+        rows.assign(roster.size(), 0);
+        for (size_t i = 0; i < roster.size(); i++) {
+            Employee *employee = roster[i];
+            const PositionDescriptor *position = findPosition(employee->getPosition());
+            if (position == nullptr) {
+                continue;
+            }
+            PositionTag tag = position->tag;
+            PayGroup &group = groups[tag];
+            positions[i] = (unsigned char)tag;
+            rows[i] = group.slot.size();
+            group.slot.push_back(i);
+            group.payRate.push_back(employee->getPayInfo()->getPayRate().getCents());
+            group.hoursWorked.push_back(employee->getPayInfo()->getHoursWorked().getHundredths());
+            // only salespeople have sales, the pay policy guarantees the employee is a Salesperson
+            if (position->payPolicy == SALES_BASED) {
+                group.sales.push_back(static_cast<Salesperson *>(employee)->getSales().getCents());
+            } else {
+                group.sales.push_back(0);
+            }
+        }
+        for (int p = 0; p < NUM_POSITIONS; p++) {
+            size_t size = groups[p].slot.size();
+            groups[p].normalPay.assign(size, 0);
+            groups[p].extraPay.assign(size, 0);
+            groups[p].weeklyPay.assign(size, 0);
+        }
+        totalWeeklyPay = Money();
+    }
+
+    /* 
+    * Purpose: To calculate the weekly pay of every loaded employee and the roster total. The roster is
+    *          split into fixed size chunks which the threads take turns calculating. Each chunk adds up
+    *          its own total, Money is exact so the company total is the same no matter how many threads are used
+    * Parameters: threads - the number of threads to use, 0 to use every core of the machine
+    * Returns: NONE
+    * Side Effects: the pay result columns and totalWeeklyPay are set
+    */
+    void compute(unsigned threads = 1) {
+        // list the chunks of every position group
+        vector<Chunk> chunks;
+        for (int p = 0; p < NUM_POSITIONS; p++) {
+            for (size_t begin = 0; begin < groups[p].slot.size(); begin += PAYROLL_CHUNK_SIZE) {
+                size_t end = begin + PAYROLL_CHUNK_SIZE < groups[p].slot.size() ? begin + PAYROLL_CHUNK_SIZE : groups[p].slot.size();
+                chunks.push_back({(PositionTag)p, begin, end});
+            }
+        }
+        vector<ChunkTotal> chunkTotals(chunks.size());
+        runOnThreads(threads, chunks.size(), [&](size_t c) {
+            computeChunk(chunks[c], chunkTotals[c].total);
+        });
+
+        // add up the chunk totals
+        totalWeeklyPay = Money();
+        for (size_t c = 0; c < chunkTotals.size(); c++) {
+            totalWeeklyPay += chunkTotals[c].total;
+        }
+    }
+
+    // get methods, slot is an index into the loaded roster
+    size_t size() const {return positions.size();}
+    Money getWeeklyPay(size_t slot) const {
+        return positions[slot] == NUM_POSITIONS ? Money() : Money::fromMicros(groups[positions[slot]].weeklyPay[rows[slot]]);
+    }
+    Money getTotalWeeklyPay() const {return totalWeeklyPay;}
+
+    /* 
+    * Purpose: To check that the engine calculates exactly the same weekly pay as the Employee classes.
+    *          A roster of employees of every position with random valid pay inputs is created, and the
+    *          weekly pay and total of the engine are compared with the employees and the roster ledger
+    * Parameters: employees - the number of employees to generate
+    *             seed - the seed of the random numbers, so a check can be repeated
+    *             threads - the number of threads the engine uses, 0 to use every core
+    * Returns: the number of weekly pays and totals that differ, 0 if the engine matches the classes
+    * Side Effects: NONE
+    */
+    static size_t selfCheck(size_t employees, unsigned seed, unsigned threads);
+
+private:
+    // a range of rows of one position group that is calculated as a single unit of work
+    struct Chunk {
+        PositionTag tag;
+        size_t begin;
+        size_t end;
+    };
+
+    /* 
+    * Purpose: To calculate the weekly pay of one chunk of employees and add up their total
+    * Parameters: chunk - the rows to calculate
+    *             total - the sum to add the weekly pay of the chunk to
+    * Returns: NONE
+    * Side Effects: the pay result columns of the chunk rows are set and total is updated
+    */
+    void computeChunk(const Chunk &chunk, Money &total) {
+        PayGroup &group = groups[chunk.tag];
+        const PositionDescriptor &position = POSITIONS[chunk.tag];
+        switch (position.payPolicy) {
+            case SALARY_BASED:
+                computeSalaried(group, chunk.begin, chunk.end);
+                break;
+            case HOURLY_BASED:
+                computeHourly(group, chunk.begin, chunk.end, position.overtimeHours, position.overtimeMultiplier);
+                break;
+            case SALES_BASED:
+                computeSales(group, chunk.begin, chunk.end, position.commissionRate);
+                break;
+        }
+        // the sum is kept in a local so the shared chunk totals are only written once
+        long long sum = 0;
+        for (size_t r = chunk.begin; r < chunk.end; r++) {
+            sum += group.weeklyPay[r];
+        }
+        total = Money::fromMicros(sum);
+    }
+
+    /* 
+    * Purpose: To calculate the weekly pay of salary based employees (see SalaryBasedEmployee::calcWeeklyPay)
+    * Parameters: group - the columns of one salary based position
+    *             begin, end - the range of rows to calculate
+    * Returns: NONE
+    * Side Effects: the pay result columns of the rows are set
+    */
+    static void computeSalaried(PayGroup &group, size_t begin, size_t end) {
+        const long long *payRate = group.payRate.data();
+        long long *normalPay = group.normalPay.data();
+        long long *weeklyPay = group.weeklyPay.data();
+        const long long salaryHours = STANDARD_WEEKLY_HOURS.getHundredths();
+        for (size_t r = begin; r < end; r++) {
+            long long pay = salaryHours * (payRate[r] * 100);
+            normalPay[r] = pay;
+            weeklyPay[r] = pay >= 0 ? pay : 0;
+        }
+    }
+
+    /* 
+    * Purpose: To calculate the weekly pay of hourly based employees (see HourlyBasedEmployee::calcWeeklyPay)
+    * Parameters: group - the columns of one hourly based position
+    *             begin, end - the range of rows to calculate
+    *             hoursForOvertime - the number of hours that must be worked to start earning overtime
+    *             overtimeMultiplier - the pay multiplier for overtime hours
+    * Returns: NONE
+    * Side Effects: the pay result columns of the rows are set
+    */
+    static void computeHourly(PayGroup &group, size_t begin, size_t end, Hours hoursForOvertime, int overtimeMultiplier) {
+        HourlyPayKernel::compute(end - begin, group.payRate.data() + begin, group.hoursWorked.data() + begin, hoursForOvertime.getHundredths(), overtimeMultiplier,
+                                 group.normalPay.data() + begin, group.extraPay.data() + begin, group.weeklyPay.data() + begin);
+    }
+
+    /* 
+    * Purpose: To calculate the weekly pay of salespeople (see Salesperson::calcWeeklyPay)
+    * Parameters: group - the columns of one sales position
+    *             begin, end - the range of rows to calculate
+    *             commissionRate - the percentage of sales paid as commission
+    * Returns: NONE
+    * Side Effects: the pay result columns of the rows are set
+    */
+    static void computeSales(PayGroup &group, size_t begin, size_t end, int commissionRate) {
+        const long long *payRate = group.payRate.data();
+        const long long *hoursWorked = group.hoursWorked.data();
+        const long long *sales = group.sales.data();
+        long long *normalPay = group.normalPay.data();
+        long long *commission = group.extraPay.data();
+        long long *weeklyPay = group.weeklyPay.data();
+        const long long standardHours = STANDARD_WEEKLY_HOURS.getHundredths();
+        for (size_t r = begin; r < end; r++) {
+            long long paidHours = hoursWorked[r] >= standardHours ? standardHours : hoursWorked[r];
+            normalPay[r] = paidHours * (payRate[r] * 100);
+            // cents * basis points is in micros
+            commission[r] = sales[r] * commissionRate;
+            long long pay = normalPay[r] + commission[r];
+            weeklyPay[r] = pay >= 0 ? pay : 0;
+        }
+    }
+}; // Class PayrollEngine
+
+/* 
+* Class: MappedFile
+* Purpose: A read only view of the whole contents of a file. The file is memory mapped
+           so it is never copied, files that cannot be mapped (such as pipes) are read
+           into memory instead
+*/
+class MappedFile {
+private:
+    // the contents of the file, whether they are mapped, and the buffer used when they are not
+    const char *data;
+    size_t size;
+    bool mapped;
+    vector<char> buffer;
+
+public:
+    /* 
+    * Purpose: To construct/initialize an empty MappedFile
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    MappedFile() : data(nullptr), size(0), mapped(false) {}
+
+    /* 
+    * Purpose: To unmap the file
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: the mapping is removed, views of the contents are no longer valid
+    */
+    ~MappedFile() {
+        close();
+    }
+
+    // a mapping cannot be shared between two objects
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // get methods
+    const char *getData() const {return data;}
+    size_t getSize() const {return size;}
+    string_view getContents() const {return string_view(data, size);}
+
+    /* 
+    * Purpose: To open a file and map its contents
+    * Parameters: filename - the name of the file to open
+    * Returns: true if the file was opened, false if it could not be
+    * Side Effects: any file opened before is closed
+    */
+    bool open(const string &filename) {
+        close();
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if ((fstat(fd, &info) == 0) && S_ISREG(info.st_mode) && (info.st_size > 0)) {
+            void *memory = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (memory != MAP_FAILED) {
+                // the file is read from start to end once so tell the kernel to read ahead
+                madvise(memory, (size_t)info.st_size, MADV_SEQUENTIAL);
+                data = (const char *)memory;
+                size = (size_t)info.st_size;
+                mapped = true;
+                ::close(fd);
+                return true;
+            }
+        }
+        // read files that cannot be mapped into the buffer
+        char chunk[1 << 16];
+        ssize_t bytesRead;
+        while ((bytesRead = read(fd, chunk, sizeof(chunk))) > 0) {
+            buffer.insert(buffer.end(), chunk, chunk + bytesRead);
+        }
+        ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return true;
+    }
+
+    /* 
+    * Purpose: To close the file
+    * Parameters: NONE
+    * Returns: NONE
+    * Side Effects: the mapping is removed or the buffer is emptied
+    */
+    void close() {
+        if (mapped) {
+            munmap((void *)data, size);
+        }
+        buffer.clear();
+        data = nullptr;
+        size = 0;
+        mapped = false;
+    }
+}; // Class MappedFile
+
+/* 
+* Class: EmployeeRecordSource
+* Purpose: An interface for anything employee records can be read from one at a time,
+           such as a text employee data file or a binary roster snapshot
+*/
+class EmployeeRecordSource {
+public:
+    // virtual destructor so sources can be destroyed through an EmployeeRecordSource pointer
+    virtual ~EmployeeRecordSource() {}
+
+    /* 
+    * Purpose: To read the next employee record
+    * Parameters: record - filled with the fields of the record
+    * Returns: false if there are no records left, true if a record was read
+    * Side Effects: the source moves past the record
+    */
+    virtual bool next(EmployeeRecord &record) = 0;
+}; // Class EmployeeRecordSource
+
+/* 
+* Class: RosterParser
+* Purpose: A class that reads employee records from the contents of an employee data file
+           without copying them. Each field is on its own line and the file ends with a line
+           holding END. Numbers are read like the >> operator reads them: leading whitespace is
+           skipped and anything after the number on its line (such as trailing spaces) is ignored
+*/
+class RosterParser : public EmployeeRecordSource {
+private:
+    // the next character to read and the end of the contents
+    const char *cursor;
+    const char *end;
+
+public:
+    /* 
+    * Purpose: To construct/initialize a RosterParser that reads from the start of some file contents
+    * Parameters: contents - the contents of an employee data file
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    RosterParser(string_view contents) : cursor(contents.data()), end(contents.data() + contents.size()) {}
+
+    /* 
+    * Purpose: To check whether the contents have all been read
+    * Parameters: NONE
+    * Returns: true if there is nothing left to read, false if there is
+    * Side Effects: NONE
+    */
+    bool atEnd() const {return cursor >= end;}
+
+    /* 
+    * Purpose: To read the next line, like getline does
+    * Parameters: NONE
+    * Returns: the line without its newline, empty if there are no lines left
+    * Side Effects: the parser moves to the start of the following line
+    */
+    string_view nextLine() {
+        if (cursor >= end) {
+            return string_view();
+        }
+        const char *newline = (const char *)memchr(cursor, '\n', end - cursor);
+        const char *lineEnd = newline != nullptr ? newline : end;
+        string_view line(cursor, lineEnd - cursor);
+        cursor = newline != nullptr ? newline + 1 : end;
+        return line;
+    }
+
+    /* 
+    * Purpose: To read a whole number from the start of a line like the >> operator does
+    * Parameters: line - the line to read
+    * Returns: the number, 0 if the line does not start with a number
+    * Side Effects: NONE
+    */
+    static int parseInt(string_view line) {
+        size_t start = 0;
+        while ((start < line.size()) && isspace((unsigned char)line[start])) {
+            start++;
+        }
+        // from_chars does not accept a leading plus sign
+        if ((start < line.size()) && (line[start] == '+')) {
+            start++;
+        }
+        int value = 0;
+        from_chars(line.data() + start, line.data() + line.size(), value);
+        return value;
+    }
+
+    /* 
+    * Purpose: To read the next employee record
+    * Parameters: record - filled with the fields of the record
+    * Returns: false if the next line is END, true if a record was read. A file that ends without END
+    *          gives a record with an empty position, just as reading it with getline does
+    * Side Effects: the parser moves past the record
+    */
+    virtual bool next(EmployeeRecord &record) {
+        record.position = nextLine();
+        if (record.position == "END") {
+            return false;
+        }
+        record.lastName = nextLine();
+        record.firstName = nextLine();
+        record.SIN = nextLine();
+        record.birthMonth = nextLine();
+        record.birthDay = parseInt(nextLine());
+        record.birthYear = parseInt(nextLine());
+        record.payRate = Money::parse(nextLine());
+        record.hoursWorked = Hours::parse(nextLine());
+        // salespeople have their sales (in whole dollars) on one more line
+        const PositionDescriptor *position = findPosition(record.position);
+        record.sales = ((position != nullptr) && position->hasSales) ? Money::fromDollars(parseInt(nextLine())) : Money();
+        return true;
+    }
+}; // Class RosterParser
+
+/* 
+* Class: RosterSnapshot
+* Purpose: A compact binary form of an employee data file that can be memory mapped and
+           read with almost no parsing. A snapshot is laid out as:
+             - a Header with a magic string, the format version and a checksum
+             - one fixed width Record per employee, in the same order as the data file
+             - a string table holding the text fields of the records, each distinct
+               string (such as a position or month) is only stored once
+           Numbers are stored in the byte order of the machine that wrote the snapshot.
+           Records hold the values as they were read, before any validation, so loading
+           a snapshot prints the same error messages as reading the data file
+*/
+class RosterSnapshot : public EmployeeRecordSource {
+private:
+    // the start of every snapshot file, and the version of the layout below
+    static constexpr char MAGIC[8] = {'E', 'M', 'P', 'S', 'N', 'A', 'P', '\0'};
+    static const uint32_t VERSION = 1;
+
+    // a text field, as a range of the string table
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        uint64_t recordCount;
+        uint64_t stringsSize;
+        // FNV-1a hash of the records and the string table
+        uint64_t checksum;
+    };
+    struct Record {
+        StringRef position;
+        StringRef lastName;
+        StringRef firstName;
+        StringRef SIN;
+        StringRef birthMonth;
+        int32_t birthDay;
+        int32_t birthYear;
+        int64_t payRateMicros;
+        int64_t hoursWorkedHundredths;
+        int64_t salesMicros;
+    };
+
+    // the records and string table of an opened snapshot, and the next record to read
+    const Record *records;
+    size_t recordCount;
+    const char *strings;
+    size_t nextRecord;
+
+public:
+    /* 
+    * Purpose: To construct/initialize a RosterSnapshot with no records
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    RosterSnapshot() : records(nullptr), recordCount(0), strings(nullptr), nextRecord(0) {}
+
+    // get methods
+    size_t size() const {return recordCount;}
+
+    /* 
+    * Purpose: To check whether some file contents are a roster snapshot
+    * Parameters: contents - the contents of a file
+    * Returns: true if the contents start with the snapshot magic string, false if they do not
+    * Side Effects: NONE
+    */
+    static bool isSnapshot(string_view contents) {
+        return (contents.size() >= sizeof(MAGIC)) && (memcmp(contents.data(), MAGIC, sizeof(MAGIC)) == 0);
+    }
+
+    /* 
+    * Purpose: To read the records of a snapshot from the contents of a mapped file. The records
+    *          are not copied so the contents must stay mapped while the snapshot is used
+    * Parameters: contents - the contents of a snapshot file
+    *             error - set to a description of the problem if the snapshot cannot be used
+    * Returns: true if the snapshot is valid, false if it is the wrong version, cut short or corrupt
+    * Side Effects: the records are ready to be read with next()
+    */
+    bool open(string_view contents, string &error) {
+        records = nullptr;
+        recordCount = 0;
+        nextRecord = 0;
+        Header header;
+        if (!isSnapshot(contents) || (contents.size() < sizeof(header))) {
+            error = "is not a roster snapshot";
+            return false;
+        }
+        memcpy(&header, contents.data(), sizeof(header));
+        if ((header.version != VERSION) || (header.recordSize != sizeof(Record))) {
+            error = "was written by an incompatible version (" + to_string(header.version) + ")";
+            return false;
+        }
+        // the record count is checked against the size of the file before it is multiplied so it cannot overflow
+        size_t bodySize = contents.size() - sizeof(header);
+        if ((header.recordCount > bodySize / sizeof(Record))
+            || (header.stringsSize != bodySize - header.recordCount * sizeof(Record))) {
+            error = "is the wrong size";
+            return false;
+        }
+        string_view body = contents.substr(sizeof(header));
+        if (checksum(body) != header.checksum) {
+            error = "failed its checksum";
+            return false;
+        }
+        // every text field must be inside the string table, even in a snapshot whose checksum was rewritten
+        const Record *stored = (const Record *)body.data();
+        for (uint64_t r = 0; r < header.recordCount; r++) {
+            const StringRef *fields[] = {&stored[r].position, &stored[r].lastName, &stored[r].firstName,
+                                         &stored[r].SIN, &stored[r].birthMonth};
+            for (const StringRef *field : fields) {
+                if ((uint64_t)field->offset + field->length > header.stringsSize) {
+                    error = "has a text field outside its string table (record " + to_string(r + 1) + ")";
+                    return false;
+                }
+            }
+        }
+        // the header size is a multiple of 8 and mappings are page aligned, so records are properly aligned
+        records = (const Record *)body.data();
+        recordCount = header.recordCount;
+        strings = body.data() + header.recordCount * sizeof(Record);
+        return true;
+    }
+
+    /* 
+    * Purpose: To read the next record of the snapshot
+    * Parameters: record - filled with the fields of the record, text fields are views into the string table
+    * Returns: false if there are no records left, true if a record was read
+    * Side Effects: the snapshot moves to the following record
+    */
+    virtual bool next(EmployeeRecord &record) {
+        if (nextRecord >= recordCount) {
+            return false;
+        }
+        const Record &stored = records[nextRecord++];
+        record.position = view(stored.position);
+        record.lastName = view(stored.lastName);
+        record.firstName = view(stored.firstName);
+        record.SIN = view(stored.SIN);
+        record.birthMonth = view(stored.birthMonth);
+        record.birthDay = stored.birthDay;
+        record.birthYear = stored.birthYear;
+        record.payRate = Money::fromMicros(stored.payRateMicros);
+        record.hoursWorked = Hours::fromHundredths(stored.hoursWorkedHundredths);
+        record.sales = Money::fromMicros(stored.salesMicros);
+        return true;
+    }
+
+    /* 
+    * Purpose: To write every record of a source to a snapshot file
+    * Parameters: source - the records to write, such as a RosterParser reading a data file
+    *             filename - the name of the snapshot file to write
+    *             count - set to the number of records written
+    *             error - set to a description of the problem if the snapshot cannot be written
+    * Returns: true if the snapshot was written, false if it was not
+    * Side Effects: the snapshot file is created or replaced
+    */
+    static bool write(EmployeeRecordSource &source, const string &filename, size_t &count, string &error) {
+        vector<Record> output;
+        string stringTable;
+        // offsets of the strings already in the table so each distinct string is stored once
+        unordered_map<string, uint32_t> stringOffsets;
+        // set once a string would end past the 32 bit offsets of a StringRef, nothing more is added then
+        bool tooMuchText = false;
+        auto intern = [&](string_view text) {
+            StringRef ref = {0, (uint32_t)text.size()};
+            auto found = stringOffsets.find(string(text));
+            if (found != stringOffsets.end()) {
+                ref.offset = found->second;
+            } else if ((uint64_t)stringTable.size() + text.size() > UINT32_MAX) {
+                tooMuchText = true;
+            } else {
+                ref.offset = (uint32_t)stringTable.size();
+                stringTable.append(text.data(), text.size());
+                stringOffsets[string(text)] = ref.offset;
+            }
+            return ref;
+        };
+        EmployeeRecord record;
+        while (source.next(record)) {
+            if (findPosition(record.position) == nullptr) {
+                error = "unknown employee position '" + string(record.position) + "'";
+                return false;
+            }
+            Record stored;
+            stored.position = intern(record.position);
+            stored.lastName = intern(record.lastName);
+            stored.firstName = intern(record.firstName);
+            stored.SIN = intern(record.SIN);
+            stored.birthMonth = intern(record.birthMonth);
+            stored.birthDay = record.birthDay;
+            stored.birthYear = record.birthYear;
+            stored.payRateMicros = record.payRate.getMicros();
+            stored.hoursWorkedHundredths = record.hoursWorked.getHundredths();
+            stored.salesMicros = record.sales.getMicros();
+            if (tooMuchText) {
+                error = "the roster has too much text for a snapshot";
+                return false;
+            }
+            output.push_back(stored);
+        }
+
+        Header header;
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.recordSize = sizeof(Record);
+        header.recordCount = output.size();
+        header.stringsSize = stringTable.size();
+        // the checksum covers the records and string table exactly as they are laid out in the file
+        uint64_t hash = checksum(string_view((const char *)output.data(), output.size() * sizeof(Record)));
+        header.checksum = checksum(stringTable, hash);
+
+        ofstream file(filename, ios::binary | ios::trunc);
+        file.write((const char *)&header, sizeof(header));
+        file.write((const char *)output.data(), output.size() * sizeof(Record));
+        file.write(stringTable.data(), stringTable.size());
+        if (!file) {
+            error = "could not write '" + filename + "'";
+            return false;
+        }
+        count = output.size();
+        return true;
+    }
+
+private:
+    /* 
+    * Purpose: To find the text of a field in the string table
+    * Parameters: ref - the range of the string table holding the text
+    * Returns: a view of the text
+    * Side Effects: NONE
+    */
+    string_view view(const StringRef &ref) const {
+        return string_view(strings + ref.offset, ref.length);
+    }
+
+    /* 
+    * Purpose: To calculate the FNV-1a hash of some bytes
+    * Parameters: bytes - the bytes to hash
+    *             hash - the hash of any bytes before these, so a hash can be built up in parts
+    * Returns: the hash
+    * Side Effects: NONE
+    */
+    static uint64_t checksum(string_view bytes, uint64_t hash = 14695981039346656037ULL) {
+        for (size_t i = 0; i < bytes.size(); i++) {
+            hash = (hash ^ (unsigned char)bytes[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+}; // Class RosterSnapshot
+
+/* 
+* Purpose: To create the employee described by an employee record at the end of a roster
+* Parameters: roster - the roster to add the employee to
+*             record - the fields of the employee
+* Returns: a pointer to the new employee, nullptr if the record is for an unknown position
+* Side Effects: the employee is created in the roster and attached to its ledger, any value
+*               that fails a check is added to the validation log of the roster
+*/
+Employee *createEmployee(Roster &roster, const EmployeeRecord &record) {
+    const PositionDescriptor *position = findPosition(record.position);
+    if (position == nullptr) {
+        return nullptr;
+    }
+    ValidationLog::Scope validation(roster.getValidationLog(), roster.size(), roster.size());
+    Employee *employee = position->create(roster, record);
+    employee->attachLedger(&roster.getLedger(), position->tag);
+    return employee;
+}
+
+size_t PayrollEngine::selfCheck(size_t employees, unsigned seed, unsigned threads) {
+    mt19937 generator(seed);
+    uniform_int_distribution<long long> rates(PayInfo::minimumWage.getCents(), Employee::maximumCompanyWage.getCents());
+    uniform_int_distribution<long long> hours(0, HOURLY_HOURS_LIMIT.getHundredths());
+    uniform_int_distribution<long long> sales(0, 200000);
+    Roster roster(employees);
+    EmployeeRecord record;
+    record.firstName = "Check";
+    record.lastName = "Payroll";
+    record.birthMonth = "January";
+    record.birthDay = 1;
+    record.birthYear = 2000;
+    for (size_t i = 0; i < employees; i++) {
+        string SIN = to_string(i);
+        record.position = POSITIONS[i % NUM_POSITIONS].title;
+        record.SIN = SIN;
+        record.payRate = Money::fromCents(rates(generator));
+        record.hoursWorked = Hours::fromHundredths(hours(generator));
+        record.sales = Money::fromDollars(sales(generator));
+        createEmployee(roster, record);
+    }
+
+    PayrollEngine payroll;
+    payroll.load(roster);
+    payroll.compute(threads);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < roster.size(); i++) {
+        if (payroll.getWeeklyPay(i) != roster[i]->getWeeklyPay()) {
+            mismatches++;
+        }
+    }
+    if (payroll.getTotalWeeklyPay() != roster.getLedger().getTotal()) {
+        mismatches++;
+    }
+    return mismatches;
+}
+
+// the sections of the reports, in the order they are printed
+enum ReportSection {PAY_REPORT, EMPLOYEE_REPORT, CHEQUES};
+
+/* 
+* Purpose: To render numbered items on several threads and write them out in order. The threads are
+*          started once by runOnThreads and each takes the next item nobody has started, rendering
+*          it into one of window slots. The calling thread renders items as well, and writes each rendered item as
+*          soon as every item before it has been written. An item is only started once the item
+*          window places before it has been written, so no more than window items are ever kept
+* Parameters: threads - the number of threads to use, 0 to use every core
+*             items - the number of items
+*             window - the number of slots, at least one
+*             render - called as render(item, slot) to render an item into a slot, on any thread
+*             emit - called as emit(slot) to write out the item in a slot and empty the slot, only
+*                    on the calling thread and in item order
+* Returns: NONE
+* Side Effects: whatever render and emit do
+*/
+template <typename Render, typename Emit>
+void renderInOrder(unsigned threads, size_t items, size_t window, Render render, Emit emit) {
+    // which slots hold a rendered item, and the number of items written, both guarded by lock
+    mutex lock;
+    condition_variable changed;
+    vector<char> rendered(window, 0);
+    size_t written = 0;
+    const thread::id caller = this_thread::get_id();
+
+    // writes every rendered item that is next in order. Only the calling thread writes, the lock is
+    // let go while an item is written as no other thread touches its slot until written moves past it
+    auto writeRendered = [&](unique_lock<mutex> &held) {
+        while ((written < items) && rendered[written % window]) {
+            size_t slot = written % window;
+            held.unlock();
+            emit(slot);
+            held.lock();
+            rendered[slot] = 0;
+            written++;
+            changed.notify_all();
+        }
+    };
+
+    runOnThreads(threads, items, [&](size_t item) {
+        bool isCaller = this_thread::get_id() == caller;
+        size_t slot = item % window;
+        unique_lock<mutex> held(lock);
+        // wait for the item that used this slot before to be written
+        while (item >= written + window) {
+            if (isCaller) {
+                writeRendered(held);
+            }
+            if (item >= written + window) {
+                changed.wait(held);
+            }
+        }
+        held.unlock();
+        render(item, slot);
+        held.lock();
+        rendered[slot] = 1;
+        if (isCaller) {
+            writeRendered(held);
+        } else {
+            changed.notify_all();
+        }
+    }, [&]() {
+        // every item has been started, the calling thread writes the rest as they are rendered
+        unique_lock<mutex> held(lock);
+        while (written < items) {
+            writeRendered(held);
+            if (written < items) {
+                changed.wait(held);
+            }
+        }
+    });
+}
+
+/* 
+* Purpose: To print one section of the reports for a roster. The roster is split into chunks of
+*          REPORT_CHUNK_SIZE employees which threads render into their own buffers, and the buffers
+*          are printed in roster order, so the text is the same for any number of threads. Only
+*          REPORT_CHUNKS_PER_THREAD chunks per thread are rendered ahead of the printed text, which
+*          keeps the memory used bounded
+* Parameters: out - the report to print to
+*             employees - the employees to print
+*             section - the section of the reports to print
+*             threads - the number of threads to use, 0 to use every core
+* Returns: NONE
+* Side Effects: the section is printed to out
+*/
+void printReportSection(ReportWriter &out, const Roster &employees, ReportSection section, unsigned threads) {
+    size_t numChunks = (employees.size() + REPORT_CHUNK_SIZE - 1) / REPORT_CHUNK_SIZE;
+    threads = threadsFor(threads, numChunks);
+    vector<ReportWriter> buffers(threads * REPORT_CHUNKS_PER_THREAD);
+
+    auto render = [&](size_t chunk, size_t slot) {
+        size_t begin = chunk * REPORT_CHUNK_SIZE;
+        size_t end = begin + REPORT_CHUNK_SIZE < employees.size() ? begin + REPORT_CHUNK_SIZE : employees.size();
+        for (size_t i = begin; i < end; i++) {
+            if (section == PAY_REPORT) {
+                employees[i]->printPayInformationReport(buffers[slot]);
+                buffers[slot] << '\n';
+            } else if (section == EMPLOYEE_REPORT) {
+                employees[i]->printEmployeeInformationReport(buffers[slot]);
+                buffers[slot] << '\n';
+            } else {
+                employees[i]->printCheque(buffers[slot]);
+            }
+        }
+    };
+    // print the rendered chunks in roster order
+    auto emit = [&](size_t slot) {
+        out.write(buffers[slot].getText().data(), buffers[slot].getText().size());
+        buffers[slot].clear();
+    };
+    renderInOrder(threads, numChunks, buffers.size(), render, emit);
+}
+
+/* 
+* Purpose: To print all three sections of the reports for a roster in a single visit to each employee.
+*          While an employee is visited their pay information report, employee information report and
+*          cheque are added to the matching section and they are reset for the next week (the ledger
+*          of the roster keeps the total up to date as they are reset). Chunks of employees are visited on multiple threads the same
+*          way as printReportSection, and are added to the sections in roster order
+* Parameters: payReport - the report the pay information reports are printed to
+*             employeeReport - the report the employee information reports are printed to
+*             cheques - the report the cheques are printed to
+*             employees - the employees to print
+*             threads - the number of threads to use, 0 to use every core
+* Returns: NONE
+* Side Effects: the sections are printed and every employee is reset
+*/
+void printFusedReportSections(ReportWriter &payReport, ReportWriter &employeeReport, ReportWriter &cheques,
+                              const Roster &employees, unsigned threads) {
+    size_t numChunks = (employees.size() + REPORT_CHUNK_SIZE - 1) / REPORT_CHUNK_SIZE;
+    threads = threadsFor(threads, numChunks);
+    size_t windowSize = threads * REPORT_CHUNKS_PER_THREAD;
+    vector<ReportWriter> payBuffers(windowSize);
+    vector<ReportWriter> employeeBuffers(windowSize);
+    vector<ReportWriter> chequeBuffers(windowSize);
+
+    auto render = [&](size_t chunk, size_t slot) {
+        size_t begin = chunk * REPORT_CHUNK_SIZE;
+        size_t end = begin + REPORT_CHUNK_SIZE < employees.size() ? begin + REPORT_CHUNK_SIZE : employees.size();
+        for (size_t i = begin; i < end; i++) {
+            employees[i]->printPayInformationReport(payBuffers[slot]);
+            payBuffers[slot] << '\n';
+            employees[i]->printEmployeeInformationReport(employeeBuffers[slot]);
+            employeeBuffers[slot] << '\n';
+            employees[i]->printCheque(chequeBuffers[slot]);
+            // start of a new week
+            employees[i]->reset();
+        }
+    };
+    // add the visited chunks to the sections in roster order
+    auto emit = [&](size_t slot) {
+        payReport.write(payBuffers[slot].getText().data(), payBuffers[slot].getText().size());
+        employeeReport.write(employeeBuffers[slot].getText().data(), employeeBuffers[slot].getText().size());
+        cheques.write(chequeBuffers[slot].getText().data(), chequeBuffers[slot].getText().size());
+        payBuffers[slot].clear();
+        employeeBuffers[slot].clear();
+        chequeBuffers[slot].clear();
+    };
+    renderInOrder(threads, numChunks, windowSize, render, emit);
+}
+
+/* 
+* Class: SpoolFile
+* Purpose: A temporary file that a section of the reports is written to so it can be
+           printed later without keeping it in memory. The file is deleted when the
+           SpoolFile is destroyed
+*/
+class SpoolFile {
+private:
+    // the path of the temporary file and the stream used to write and read it
+    string path;
+    fstream file;
+    // the report written to the file
+    ReportWriter writer;
+
+public:
+    /* 
+    * Purpose: To construct/initialize a SpoolFile with no file
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    SpoolFile() : writer(file) {}
+
+    /* 
+    * Purpose: To delete the temporary file
+    * Parameters: NONE
+    * Returns: Not Applicable
+    * Side Effects: the temporary file is closed and deleted
+    */
+    ~SpoolFile() {
+        file.close();
+        if (!path.empty()) {
+            remove(path.c_str());
+        }
+    }
+
+    // a temporary file belongs to a single object
+    SpoolFile(const SpoolFile &) = delete;
+    SpoolFile &operator=(const SpoolFile &) = delete;
+
+    /* 
+    * Purpose: To create the temporary file in $TMPDIR (or /tmp)
+    * Parameters: NONE
+    * Returns: true if the file was created, false if it could not be
+    * Side Effects: a temporary file is created
+    */
+    bool open() {
+        const char *directory = getenv("TMPDIR");
+        string pattern = string(directory != nullptr ? directory : "/tmp") + "/employee-spool-XXXXXX";
+        vector<char> name(pattern.begin(), pattern.end());
+        name.push_back('\0');
+        int fd = mkstemp(name.data());
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        path = name.data();
+        file.open(path, ios::in | ios::out | ios::trunc | ios::binary);
+        return file.is_open();
+    }
+
+    // get methods
+    ReportWriter &getWriter() {return writer;}
+
+    /* 
+    * Purpose: To print everything written to the file so far
+    * Parameters: out - the report to print to
+    * Returns: NONE
+    * Side Effects: the file is read from the start
+    */
+    void copyTo(ReportWriter &out) {
+        writer.flush();
+        file.flush();
+        file.seekg(0);
+        vector<char> chunk(REPORT_BUFFER_BYTES);
+        while (file.read(chunk.data(), chunk.size()) || (file.gcount() > 0)) {
+            out.write(chunk.data(), file.gcount());
+        }
+        file.clear();
+    }
+}; // Class SpoolFile
+
+/* 
+* Purpose: To print how many heap allocations reading in the employees took. This goes to cerr
+*          so the reports printed to cout are not changed
+* Parameters: allocations - the number of heap allocations made while reading the employees
+*             numEmployees - the number of employees read
+* Returns: NONE
+* Side Effects: the numbers are printed to cerr
+*/
+void printAllocationStats(size_t allocations, size_t numEmployees) {
+    cerr << "Heap allocations while reading employees: " << allocations;
+    if (numEmployees > 0) {
+        cerr << " (" << std::setprecision(2) << std::fixed << (double)allocations / numEmployees << " per employee)";
+    }
+    cerr << endl;
+}
+
+/* 
+* Purpose: To print a string as a JSON string, with quotes and escapes
+* Parameters: out - the stream to print to
+*             text - the string to print
+* Returns: NONE
+* Side Effects: the string is printed to out
+*/
+void printJsonString(ostream &out, string_view text) {
+    static const char hexDigits[] = "0123456789abcdef";
+    out << '"';
+    for (size_t c = 0; c < text.size(); c++) {
+        unsigned char character = (unsigned char)text[c];
+        if ((character == '"') || (character == '\\')) {
+            out << '\\' << text[c];
+        } else if (character < 0x20) {
+            out << "\\u00" << hexDigits[character >> 4] << hexDigits[character & 0xf];
+        } else {
+            out << text[c];
+        }
+    }
+    out << '"';
+}
+
+// names of the validation rules in JSON, indexed by ValidationRule
+const char *const VALIDATION_RULE_NAMES[] = {"pay-rate-invalid", "hours-invalid", "hours-over-limit", "sales-negative"};
+
+/* 
+* Purpose: To print the validation issues of a roster in input order and clear its validation log.
+*          Issues are printed as error messages to out, or as one JSON object per line when json is given
+* Parameters: roster - the roster whose validation log is printed
+*             firstEmployee - the number of the first employee of the roster in the data file, counting from 0
+*             out - the stream error messages are printed to
+*             json - the stream to print JSON to, nullptr to print error messages to out
+* Returns: the number of issues printed
+* Side Effects: the issues are printed and the validation log of the roster is cleared
+*/
+size_t printValidationIssues(Roster &roster, size_t firstEmployee, ostream &out, ostream *json) {
+    ValidationLog &log = roster.getValidationLog();
+    if (log.empty()) {
+        return 0;
+    }
+    vector<ValidationIssue> issues = log.inOrder();
+    for (size_t i = 0; i < issues.size(); i++) {
+        const ValidationIssue &issue = issues[i];
+        const Employee *employee = roster[issue.slot];
+        if (json == nullptr) {
+            printValidationIssue(out, *employee, issue.rule, issue.value);
+            continue;
+        }
+        const Name *name = employee->getPersonalInfo()->getName();
+        *json << "{\"employee\":" << firstEmployee + issue.slot + 1 << ",\"rule\":\"" << VALIDATION_RULE_NAMES[issue.rule]
+              << "\",\"position\":";
+        printJsonString(*json, employee->getPosition());
+        *json << ",\"firstName\":";
+        printJsonString(*json, name->getFirstName());
+        *json << ",\"lastName\":";
+        printJsonString(*json, name->getLastName());
+        *json << ",\"SIN\":";
+        printJsonString(*json, employee->getPersonalInfo()->getSIN());
+        *json << ",\"value\":\"";
+        if ((issue.rule == HOURS_INVALID) || (issue.rule == HOURS_OVER_LIMIT)) {
+            *json << Hours::fromHundredths(issue.value);
+        } else {
+            *json << Money::fromMicros(issue.value);
+        }
+        *json << "\"}\n";
+    }
+    out.flush();
+    log.clear();
+    return issues.size();
+}
+
+/* 
+* Purpose: To print the staffing limits a roster breaks
+* Parameters: out - the stream to print to
+*             violations - the messages from RosterPolicy::check
+* Returns: NONE
+* Side Effects: the violations are printed to out
+*/
+void printPolicyViolations(ostream &out, const vector<string> &violations) {
+    for (size_t v = 0; v < violations.size(); v++) {
+        out << "POLICY: " << violations[v] << endl;
+    }
+}
+
+/* 
+* Purpose: To print the company summary and the closing message
+* Parameters: out - the report to print to
+*             numEmployees - the number of employees in the company
+*             totalWeeklyPay - the total weekly pay of every employee
+* Returns: NONE
+* Side Effects: the summary is printed to out
+*/
+void printCompanySummary(ReportWriter &out, size_t numEmployees, Money totalWeeklyPay) {
+    // line break for spacing
+    out << '\n';
+    // print company summary with number of employees and total weekly pay out.
+    out << summaryHeading << '\n';
+    out << "Number of Employees: " << numEmployees << '\n';
+    out << "Total Weekly Pay: $" << totalWeeklyPay << '\n';
+    
+    out << '\n';
+    
+    // closing message
+    out << "Thank you for using this employee HR management system!\n";
+}
+
+/* 
+* Class: PayrollOptions
+* Purpose: The command line options that change how a payroll is read, checked and printed
+*/
+struct PayrollOptions {
+    // whether the staffing limits of the company should be checked
+    bool enforceLimits = false;
+    // whether the number of heap allocations made while reading the file should be reported
+    bool allocationStats = false;
+    // whether employees sharing a SIN should be reported
+    bool checkSINs = false;
+    // whether the employees should be streamed through in batches instead of all kept in memory
+    bool streamMode = false;
+    // whether the reports should be printed in a single visit to each employee
+    bool fusedMode = false;
+    // number of threads used to calculate the payroll and print the reports, 0 to use every core
+    unsigned threads = 0;
+    // timesheet delta file applied to the roster before the reports are printed, empty for none
+    string deltaFile;
+    // timesheet delta files of the pay periods to run in batch mode, empty when not in batch mode
+    vector<string> periodFiles;
+    // file the validation issues are written to as JSON, empty to print them as error messages
+    string errorsJsonFile;
+    // whether the time and records of each stage of the run should be printed as JSON
+    bool stats = false;
+};
+
+// the stages of a payroll run that --stats times
+enum StatStage {PARSE_STAGE, CONSTRUCT_STAGE, CHECK_STAGE, DELTA_STAGE, PAYROLL_STAGE, PAY_REPORT_STAGE,
+                EMPLOYEE_REPORT_STAGE, CHEQUES_STAGE, FUSED_REPORTS_STAGE, RESET_STAGE, OUTPUT_STAGE, SUMMARY_STAGE,
+                NUM_STAT_STAGES};
+// names of the stages in the JSON, indexed by StatStage
+const char *const STAT_STAGE_NAMES[NUM_STAT_STAGES] = {"parse", "construct", "check", "delta", "payroll", "pay-report",
+                                                       "employee-report", "cheques", "fused-reports", "reset",
+                                                       "output", "summary"};
+
+/* 
+* Class: RunStats
+* Purpose: Timers and counters for each stage of a payroll run, printed as JSON with --stats.
+           Nothing is timed when --stats is not given, as the run then has no RunStats
+*/
+class RunStats {
+public:
+    typedef chrono::steady_clock Clock;
+
+private:
+    // time spent in and records handled by each stage, and whether the stage ran at all
+    Clock::duration stageTime[NUM_STAT_STAGES] = {};
+    size_t stageRecords[NUM_STAT_STAGES] = {};
+    bool stageRan[NUM_STAT_STAGES] = {};
+    // time spent constructing, and number constructed, of each position
+    Clock::duration constructTime[NUM_POSITIONS] = {};
+    size_t constructCount[NUM_POSITIONS] = {};
+
+public:
+    // bytes of input read and of reports written, and the number of validation errors found
+    size_t bytesRead = 0;
+    size_t bytesWritten = 0;
+    size_t validationErrors = 0;
+
+    /* 
+    * Purpose: To add time spent in a stage
+    * Parameters: stage - the stage
+    *             time - the time spent
+    *             records - the number of records handled in that time
+    * Returns: NONE
+    * Side Effects: the totals of the stage are updated
+    */
+    void add(StatStage stage, Clock::duration time, size_t records) {
+        stageTime[stage] += time;
+        stageRecords[stage] += records;
+        stageRan[stage] = true;
+    }
+
+    /* 
+    * Purpose: To add the time spent constructing one employee
+    * Parameters: position - the position of the employee
+    *             time - the time spent
+    * Returns: NONE
+    * Side Effects: the totals of the construct stage and of the position are updated
+    */
+    void addConstruction(PositionTag position, Clock::duration time) {
+        add(CONSTRUCT_STAGE, time, 1);
+        constructTime[position] += time;
+        constructCount[position]++;
+    }
+
+    /* 
+    * Purpose: To print the statistics as JSON
+    * Parameters: out - the stream to print to
+    *             employees - the number of employees in the run
+    * Returns: NONE
+    * Side Effects: the statistics are printed to out
+    */
+    void print(ostream &out, size_t employees) const {
+        out << "{\n  \"employees\": " << employees << ",\n  \"bytesRead\": " << bytesRead
+            << ",\n  \"bytesWritten\": " << bytesWritten << ",\n  \"validationErrors\": " << validationErrors
+            << ",\n  \"stages\": [";
+        const char *separator = "\n";
+        for (int stage = 0; stage < NUM_STAT_STAGES; stage++) {
+            if (stageRan[stage]) {
+                out << separator << "    {\"name\": \"" << STAT_STAGE_NAMES[stage] << "\", ";
+                printTiming(out, stageTime[stage], stageRecords[stage]);
+                out << "}";
+                separator = ",\n";
+            }
+        }
+        out << "\n  ],\n  \"construction\": [";
+        separator = "\n";
+        for (int position = 0; position < NUM_POSITIONS; position++) {
+            if (constructCount[position] > 0) {
+                out << separator << "    {\"position\": \"" << POSITIONS[position].title << "\", ";
+                printTiming(out, constructTime[position], constructCount[position]);
+                out << "}";
+                separator = ",\n";
+            }
+        }
+        out << "\n  ]\n}" << endl;
+    }
+
+private:
+    /* 
+    * Purpose: To print the time and record rate of a stage as JSON fields
+    * Parameters: out - the stream to print to
+    *             time - the time spent
+    *             records - the number of records handled in that time
+    * Returns: NONE
+    * Side Effects: the fields are printed to out
+    */
+    static void printTiming(ostream &out, Clock::duration time, size_t records) {
+        double seconds = chrono::duration<double>(time).count();
+        out << "\"seconds\": " << fixed << setprecision(6) << seconds << ", \"records\": " << records
+            << ", \"recordsPerSecond\": " << setprecision(0) << (seconds > 0 ? records / seconds : 0.0);
+    }
+}; // Class RunStats
+
+/* 
+* Class: StageTimer
+* Purpose: Times a stage of a payroll run from when it is created. Laps can be taken to time
+           a stage that runs in many small pieces, such as reading each employee. When there
+           is no RunStats the clock is never read
+*/
+class StageTimer {
+private:
+    RunStats *stats;
+    RunStats::Clock::time_point last;
+
+public:
+    /* 
+    * Purpose: To start timing
+    * Parameters: stats - the statistics the times are added to, nullptr to time nothing
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    explicit StageTimer(RunStats *stats) : stats(stats) {
+        if (stats != nullptr) {
+            last = RunStats::Clock::now();
+        }
+    }
+
+    /* 
+    * Purpose: To add the time since the last lap to a stage and start the next lap
+    * Parameters: stage - the stage
+    *             records - the number of records handled since the last lap
+    * Returns: NONE
+    * Side Effects: the time is added to the statistics
+    */
+    void lap(StatStage stage, size_t records = 1) {
+        if (stats != nullptr) {
+            RunStats::Clock::time_point now = RunStats::Clock::now();
+            stats->add(stage, now - last, records);
+            last = now;
+        }
+    }
+
+    /* 
+    * Purpose: To add the time since the last lap to the construction of an employee and start the next lap
+    * Parameters: employee - the employee constructed
+    * Returns: NONE
+    * Side Effects: the time is added to the statistics
+    */
+    void lapConstruction(const Employee *employee) {
+        if (stats != nullptr) {
+            RunStats::Clock::time_point now = RunStats::Clock::now();
+            stats->addConstruction(findPosition(employee->getPosition())->tag, now - last);
+            last = now;
+        }
+    }
+}; // Class StageTimer
+
+/* 
+* Class: CompanyTotals
+* Purpose: The number of employees and total weekly pay of one company, used to sum up several companies
+*/
+struct CompanyTotals {
+    size_t employees = 0;
+    Money weeklyPay;
+};
+
+/* 
+* Purpose: To describe an employee whose SIN is already held by an earlier employee
+* Parameters: employee - the number of the employee in the data file, counting from 0
+*             firstEmployee - the number of the earlier employee holding the SIN
+*             SIN - the SIN they share
+* Returns: the description, numbering employees from 1 in the order they are in the data file
+* Side Effects: NONE
+*/
+string describeDuplicateSIN(size_t employee, size_t firstEmployee, string_view SIN) {
+    return "employee " + to_string(employee + 1) + " has SIN " + string(SIN) + ", which employee "
+           + to_string(firstEmployee + 1) + " already has.";
+}
+
+/* 
+* Purpose: To print the employees that share a SIN with an earlier employee
+* Parameters: out - the stream to print to
+*             duplicates - the descriptions made by describeDuplicateSIN
+* Returns: NONE
+* Side Effects: the duplicates are printed to out
+*/
+void printDuplicateSINs(ostream &out, const vector<string> &duplicates) {
+    for (size_t d = 0; d < duplicates.size(); d++) {
+        out << "DUPLICATE: " << duplicates[d] << endl;
+    }
+}
+
+/* 
+* Purpose: To take the next field of a line, fields are separated by whitespace
+* Parameters: line - the rest of the line, the field is removed from its start
+* Returns: the field, empty if the line has no more fields
+* Side Effects: NONE
+*/
+string_view nextField(string_view &line) {
+    size_t start = 0;
+    while ((start < line.size()) && isspace((unsigned char)line[start])) {
+        start++;
+    }
+    size_t end = start;
+    while ((end < line.size()) && !isspace((unsigned char)line[end])) {
+        end++;
+    }
+    string_view field = line.substr(start, end - start);
+    line.remove_prefix(end);
+    return field;
+}
+
+/* 
+* Purpose: To check whether a field holds a decimal number such as "40" or "31.5"
+* Parameters: field - the field to check
+* Returns: true if the field is a number
+* Side Effects: NONE
+*/
+bool isDecimalField(string_view field) {
+    bool digits = false;
+    bool point = false;
+    for (size_t i = 0; i < field.size(); i++) {
+        if ((field[i] >= '0') && (field[i] <= '9')) {
+            digits = true;
+        } else if ((field[i] == '.') && !point) {
+            point = true;
+        } else if (((field[i] != '-') && (field[i] != '+')) || (i > 0)) {
+            return false;
+        }
+    }
+    return digits;
+}
+
+/* 
+* Purpose: To apply a timesheet delta to a roster that is already loaded. Each line of a delta holds
+*          "SIN hours [sales]", the hours worked this week and, for salespeople, this week's sales in dollars.
+*          Employees are found through a SinIndex of the roster and only the employees named in the delta are changed,
+*          through setHoursWorked and setSales so the usual validation applies and their weekly pay and the
+*          roster ledger are recalculated. When several employees share a SIN the first of them is changed.
+*          Blank lines are skipped and later lines win when a SIN is listed twice
+* Parameters: roster - the roster to change
+*             sinIndex - an index of the roster made with SinIndex::build
+*             contents - the text of the delta file
+*             problems - filled with a description of every line that could not be applied
+* Returns: the number of lines applied
+* Side Effects: employees of the roster are changed, values that fail a check are added to the
+*               validation log of the roster in the order of the lines they are on
+*/
+size_t applyTimesheetDelta(Roster &roster, const SinIndex &sinIndex, string_view contents, vector<string> &problems) {
+    size_t applied = 0;
+    size_t lineNumber = 0;
+    while (!contents.empty()) {
+        size_t newline = contents.find('\n');
+        string_view line = contents.substr(0, newline);
+        contents.remove_prefix(newline == string_view::npos ? contents.size() : newline + 1);
+        lineNumber++;
+
+        string_view SIN = nextField(line);
+        if (SIN.empty()) {
+            continue;
+        }
+        string_view hours = nextField(line);
+        string_view sales = nextField(line);
+        if (!isDecimalField(hours) || (!sales.empty() && !isDecimalField(sales)) || !nextField(line).empty()) {
+            problems.push_back("line " + to_string(lineNumber) + " is not 'SIN hours [sales]', it was skipped.");
+            continue;
+        }
+        size_t slot = sinIndex.find(parseSIN(SIN));
+        if (slot == SinIndex::NOT_FOUND) {
+            problems.push_back("line " + to_string(lineNumber) + ": no employee has SIN " + string(SIN) + ", it was skipped.");
+            continue;
+        }
+        Employee *employee = roster[slot];
+        ValidationLog::Scope validation(roster.getValidationLog(), slot, lineNumber);
+        if (!sales.empty()) {
+            const PositionDescriptor *position = findPosition(employee->getPosition());
+            if (!position->hasSales) {
+                problems.push_back("line " + to_string(lineNumber) + ": the employee with SIN " + string(SIN)
+                                   + " is not a salesperson, it was skipped.");
+                continue;
+            }
+            // the position guarantees the employee is a Salesperson
+            static_cast<Salesperson *>(employee)->setSales(Money::parse(sales));
+        }
+        employee->setHoursWorked(Hours::parse(hours));
+        applied++;
+    }
+    return applied;
+}
+
+/* 
+* Purpose: To print the lines of a timesheet delta that could not be applied
+* Parameters: out - the stream to print to
+*             problems - the descriptions made by applyTimesheetDelta
+* Returns: NONE
+* Side Effects: the problems are printed to out
+*/
+void printDeltaProblems(ostream &out, const vector<string> &problems) {
+    for (size_t p = 0; p < problems.size(); p++) {
+        out << "DELTA: " << problems[p] << endl;
+    }
+}
+
+/* 
+* Purpose: To run several weekly pay periods for a roster that is loaded once. Before each period every
+*          employee is reset for a new week, then the timesheet delta of the period (see applyTimesheetDelta)
+*          gives the hours and sales worked that week. The summary of each period is printed, followed by
+*          the combined total of every period. The hours and sales in the data file itself are not a period
+* Parameters: employees - the roster to pay
+*             options - the options for the run, periodFiles lists the timesheet delta of each period
+*             out - the stream to print to
+*             errorsJson - the stream validation issues are printed to as JSON, nullptr to print error messages
+*             timer - the timer of the run, each period is timed as a delta stage
+*             stats - the statistics of the run, printed once every period is done, nullptr for none
+*             validationErrors - the validation errors already found while the roster was read in
+* Returns: the exit status of the program, 0 on success and 99 if a timesheet delta could not be opened
+* Side Effects: the employees are changed, the period summaries are printed to out and the statistics to cerr
+*/
+int runPayPeriods(Roster &employees, const PayrollOptions &options, ostream &out, ostream *errorsJson,
+                  StageTimer &timer, RunStats *stats, size_t validationErrors) {
+    // the roster is indexed once for every period
+    SinIndex sinIndex;
+    sinIndex.build(employees, options.threads);
+    Money combinedPay;
+    size_t deltaBytes = 0;
+    // the headings and summaries are written through a ReportWriter so the bytes written are counted,
+    // it is flushed before the validation issues and delta problems are printed straight to out
+    ReportWriter report(out);
+
+    for (size_t period = 0; period < options.periodFiles.size(); period++) {
+        MappedFile deltaFile;
+        if (!deltaFile.open(options.periodFiles[period])) {
+            out << "(U): Unable to open '" << options.periodFiles[period] << "'... aborting." << endl;
+            return 99;
+        }
+        // start of a new week
+        for (size_t i = 0; i < employees.size(); i++) {
+            employees[i]->reset();
+        }
+        timer.lap(RESET_STAGE, employees.size());
+        report << '\n';
+        report << "-------- Pay Period " << period + 1 << ": " << options.periodFiles[period] << " --------\n";
+        report.flush();
+        vector<string> problems;
+        size_t applied = applyTimesheetDelta(employees, sinIndex, deltaFile.getContents(), problems);
+        validationErrors += printValidationIssues(employees, 0, out, errorsJson);
+        printDeltaProblems(out, problems);
+        deltaBytes += deltaFile.getSize();
+        timer.lap(DELTA_STAGE, applied);
+        // the roster ledger holds the total of the period without adding up every employee
+        Money periodPay = employees.getLedger().getTotal();
+        combinedPay += periodPay;
+        report << "Number of Employees: " << employees.size() << '\n';
+        report << "Total Weekly Pay: $" << periodPay << '\n';
+        timer.lap(SUMMARY_STAGE, 0);
+    }
+
+    report << '\n';
+    report << batchSummaryHeading << '\n';
+    report << "Number of Pay Periods: " << options.periodFiles.size() << '\n';
+    report << "Total Pay: $" << combinedPay << '\n';
+    report << '\n';
+    // closing message
+    report << "Thank you for using this employee HR management system!\n";
+    report.flush();
+    timer.lap(SUMMARY_STAGE, 0);
+
+    // the statistics go to cerr so the reports printed to out are not changed
+    if (stats != nullptr) {
+        stats->validationErrors += validationErrors;
+        stats->bytesRead += deltaBytes;
+        stats->bytesWritten = report.getBytesWritten();
+        stats->print(cerr, employees.size());
+    }
+    return 0;
+}
+
+/* 
+* Purpose: To read, calculate and print the payroll of a company with a bounded amount of memory.
+*          Employees are read in batches of STREAM_BATCH_SIZE and each batch is printed and freed
+*          before the next one is read. Error messages are printed with each batch, and each report
+*          section is written to a temporary file which is printed once the whole file has been read,
+*          so the output is the same as when the whole roster is kept in memory
+*          Checking SINs keeps every SIN read in a SinIndex, which is the only memory that grows with the roster
+* Parameters: parser - the source of the employee records, such as a parser reading the employee data file
+*             options - the options for the run
+*             out - the stream to print the reports to
+*             errorsJson - the stream validation issues are printed to as JSON, nullptr to print error messages
+*             stats - the statistics the time of each stage is added to and printed from, nullptr for none
+*             totals - set to the number of employees and total weekly pay of the company, nullptr if not needed
+* Returns: the exit status of the program, 0 on success and 99 if an unknown position was read
+* Side Effects: the reports are printed to out
+*/
+int streamPayroll(EmployeeRecordSource &parser, const PayrollOptions &options, ostream &out, ostream *errorsJson,
+                  RunStats *stats, CompanyTotals *totals) {
+    SpoolFile paySection;
+    SpoolFile employeeSection;
+    SpoolFile chequeSection;
+    if (!paySection.open() || !employeeSection.open() || !chequeSection.open()) {
+        out << "(U): Unable to create temporary files for streaming... aborting." << endl;
+        return 99;
+    }
+    Roster batch(STREAM_BATCH_SIZE);
+    RosterPolicy policy = RosterPolicy::companyDefault();
+    vector<size_t> policyCounts;
+    SinIndex sinIndex;
+    vector<string> duplicateSINs;
+    EmployeeRecord record;
+    size_t numEmployees = 0;
+    Money totalWeeklyPay;
+    size_t allocationsBeforeIngest = heapAllocations.load();
+    size_t validationErrors = 0;
+    StageTimer timer(stats);
+
+    bool moreRecords = true;
+    while (moreRecords) {
+        moreRecords = parser.next(record);
+        timer.lap(PARSE_STAGE, moreRecords ? 1 : 0);
+        Employee *employee = moreRecords ? createEmployee(batch, record) : nullptr;
+        if (moreRecords && (employee == nullptr)) {
+            printValidationIssues(batch, numEmployees, out, errorsJson);
+            out << "(U): Unknown employee position '" << record.position << "'... aborting." << endl;
+            return 99;
+        }
+        if (moreRecords) {
+            timer.lapConstruction(employee);
+        }
+        // print the batch once it is full or the file has ended
+        if ((batch.size() == STREAM_BATCH_SIZE) || (!moreRecords && (batch.size() > 0))) {
+            validationErrors += printValidationIssues(batch, numEmployees, out, errorsJson);
+            timer.lap(OUTPUT_STAGE, 0);
+            if (options.checkSINs) {
+                for (size_t i = 0; i < batch.size(); i++) {
+                    const PersonalInfo *info = batch[i]->getPersonalInfo();
+                    size_t first = sinIndex.insert(info->getPackedSIN(), numEmployees + i);
+                    if ((first != SinIndex::NOT_FOUND) && (first != numEmployees + i)) {
+                        duplicateSINs.push_back(describeDuplicateSIN(numEmployees + i, first, info->getSIN()));
+                    }
+                }
+            }
+            // the batch keeps its total weekly pay up to date, it is taken before the employees are reset
+            totalWeeklyPay += batch.getLedger().getTotal();
+            if (options.fusedMode) {
+                printFusedReportSections(paySection.getWriter(), employeeSection.getWriter(),
+                                         chequeSection.getWriter(), batch, options.threads);
+                timer.lap(FUSED_REPORTS_STAGE, batch.size());
+            } else {
+                printReportSection(paySection.getWriter(), batch, PAY_REPORT, options.threads);
+                timer.lap(PAY_REPORT_STAGE, batch.size());
+                printReportSection(employeeSection.getWriter(), batch, EMPLOYEE_REPORT, options.threads);
+                timer.lap(EMPLOYEE_REPORT_STAGE, batch.size());
+                printReportSection(chequeSection.getWriter(), batch, CHEQUES, options.threads);
+                timer.lap(CHEQUES_STAGE, batch.size());
+            }
+            if (options.enforceLimits) {
+                policy.tally(batch, policyCounts);
+            }
+            if (options.checkSINs || options.enforceLimits) {
+                timer.lap(CHECK_STAGE, batch.size());
+            }
+            numEmployees += batch.size();
+            batch.clear();
+            timer.lap(RESET_STAGE, 0);
+        }
+    }
+
+    if (options.allocationStats) {
+        printAllocationStats(heapAllocations.load() - allocationsBeforeIngest, numEmployees);
+    }
+    if (options.enforceLimits) {
+        printPolicyViolations(out, policy.check(policyCounts));
+    }
+    if (options.checkSINs) {
+        printDuplicateSINs(out, duplicateSINs);
+    }
+
+    // add a line break before printing reports
+    ReportWriter report(out);
+    report << '\n';
+    report << payReportHeading << '\n';
+    paySection.copyTo(report);
+    report << employeeReportHeading << '\n';
+    employeeSection.copyTo(report);
+    report << chequesHeading << '\n';
+    chequeSection.copyTo(report);
+    timer.lap(OUTPUT_STAGE, 0);
+    printCompanySummary(report, numEmployees, totalWeeklyPay);
+    report.flush();
+    timer.lap(SUMMARY_STAGE, 0);
+
+    if (totals != nullptr) {
+        totals->employees = numEmployees;
+        totals->weeklyPay = totalWeeklyPay;
+    }
+    // the statistics go to cerr so the reports printed to out are not changed
+    if (stats != nullptr) {
+        stats->validationErrors += validationErrors;
+        stats->bytesWritten = report.getBytesWritten();
+        stats->print(cerr, numEmployees);
+    }
+    return 0;
+}
+
+/* 
+* Class: PositionMix
+* Purpose: How the employees of a synthetic roster are spread across the positions. Each
+           position gets weight employees in turn, so a mix with weights 3 and 1 makes
+           three employees of the first position for every one of the second
+*/
+struct PositionMix {
+    const char *name;
+    unsigned weights[NUM_POSITIONS];
+};
+
+// the named position mixes, the first is used when no mix is given
+const PositionMix POSITION_MIXES[] = {
+    {"mixed", {1, 1, 1, 1, 1, 1}},
+    {"salaried", {1, 1, 0, 0, 0, 0}},
+    {"hourly", {0, 0, 1, 1, 0, 0}},
+    {"sales", {0, 0, 0, 0, 1, 1}},
+};
+const size_t NUM_POSITION_MIXES = sizeof(POSITION_MIXES) / sizeof(POSITION_MIXES[0]);
+
+/* 
+* Purpose: To read a position mix, either the name of one of POSITION_MIXES or a comma separated
+*          list of position titles, each with an optional weight after a colon (such as "manager:3,secretary")
+* Parameters: text - the mix to read
+*             mix - set to the mix read
+* Returns: true if the mix was read, false if a position is unknown or no position has a weight
+* Side Effects: NONE
+*/
+bool parsePositionMix(string_view text, PositionMix &mix) {
+    for (size_t m = 0; m < NUM_POSITION_MIXES; m++) {
+        if (text == POSITION_MIXES[m].name) {
+            mix = POSITION_MIXES[m];
+            return true;
+        }
+    }
+    mix = PositionMix{"custom", {0, 0, 0, 0, 0, 0}};
+    unsigned totalWeight = 0;
+    while (!text.empty()) {
+        size_t comma = text.find(',');
+        string_view entry = text.substr(0, comma);
+        text.remove_prefix(comma == string_view::npos ? text.size() : comma + 1);
+        size_t colon = entry.find(':');
+        unsigned weight = 1;
+        if (colon != string_view::npos) {
+            string_view digits = entry.substr(colon + 1);
+            if (from_chars(digits.data(), digits.data() + digits.size(), weight).ptr != digits.data() + digits.size()) {
+                return false;
+            }
+            entry = entry.substr(0, colon);
+        }
+        const PositionDescriptor *position = findPosition(entry);
+        if (position == nullptr) {
+            return false;
+        }
+        mix.weights[position->tag] += weight;
+        totalWeight += weight;
+    }
+    return totalWeight > 0;
+}
+
+/* 
+* Purpose: To add a whole number of hundredths to a string, with two decimal places
+* Parameters: text - the string to add to
+*             hundredths - the number to add
+* Returns: NONE
+* Side Effects: the number is appended to text
+*/
+void appendHundredths(string &text, long long hundredths) {
+    char buffer[MAX_FORMATTED_CHARS];
+    char *end = buffer + MAX_FORMATTED_CHARS;
+    char *begin = formatHundredths(end, hundredths);
+    text.append(begin, end - begin);
+}
+
+/* 
+* Purpose: To add a whole number to a string
+* Parameters: text - the string to add to
+*             value - the number to add
+*             digits - the least number of digits, leading zeros are added to reach it
+* Returns: NONE
+* Side Effects: the number is appended to text
+*/
+void appendInteger(string &text, long long value, size_t digits = 0) {
+    char buffer[MAX_FORMATTED_CHARS];
+    char *end = buffer + MAX_FORMATTED_CHARS;
+    char *begin = formatInteger(end, value);
+    if ((size_t)(end - begin) < digits) {
+        text.append(digits - (end - begin), '0');
+    }
+    text.append(begin, end - begin);
+}
+
+/* 
+* Class: SyntheticRosterOptions
+* Purpose: What a synthetic roster should contain
+*/
+struct SyntheticRosterOptions {
+    // number of employees in the roster
+    size_t employees = 0;
+    // how the employees are spread across the positions
+    PositionMix mix = POSITION_MIXES[0];
+    // seed of the random numbers, the same options always make the same roster
+    unsigned seed = 1;
+    // fraction of employees given one invalid value: a pay rate under minimum wage, hours over
+    // the hourly limit for hourly employees or negative sales for salespeople
+    double invalidFraction = 0;
+    // fraction of employees given the SIN of an earlier employee, every other SIN is unique
+    double duplicateFraction = 0;
+};
+
+/* 
+* Class: SyntheticRoster
+* Purpose: Makes the text of an employee data file with random employees, in the format
+           RosterParser reads. The roster can be made in pieces so a roster of any size can be
+           written out without holding all of it. Only mt19937, whose numbers are fixed by the
+           standard, is used for randomness so a seed makes the same roster on every platform
+*/
+class SyntheticRoster {
+private:
+    // multiplier making a unique nine digit SIN from the number of an employee, it has no factor in common with 10^9
+    static constexpr unsigned long long SIN_MULTIPLIER = 387420489;
+    static constexpr unsigned long long SIN_COUNT = 1000000000;
+    SyntheticRosterOptions options;
+    // one turn of the position mix, employee i gets cycle[i % cycle.size()]
+    vector<PositionTag> cycle;
+    mt19937 generator;
+    // number of employees made so far
+    size_t made;
+    // chances out of 2^32 of an invalid value and of a duplicate SIN
+    unsigned long long invalidChance;
+    unsigned long long duplicateChance;
+    // added to every SIN so different seeds give different SINs
+    unsigned long long sinOffset;
+
+public:
+    /* 
+    * Purpose: To construct/initialize a SyntheticRoster that has not made any employees yet
+    * Parameters: options - what the roster should contain
+    * Returns: Not Applicable
+    * Side Effects: NONE
+    */
+    SyntheticRoster(const SyntheticRosterOptions &options) : options(options), generator(options.seed), made(0) {
+        for (int p = 0; p < NUM_POSITIONS; p++) {
+            cycle.insert(cycle.end(), options.mix.weights[p], (PositionTag)p);
+        }
+        invalidChance = (unsigned long long)(options.invalidFraction * 4294967296.0);
+        duplicateChance = (unsigned long long)(options.duplicateFraction * 4294967296.0);
+        sinOffset = generator() % SIN_COUNT;
+    }
+
+    /* 
+    * Purpose: To add the next employees of the roster to a string, followed by the END line
+    *          once the last employee has been made
+    * Parameters: text - the string to add to
+    *             count - the most employees to add
+    * Returns: true if there are employees left to make, false if the roster is finished
+    * Side Effects: the employees are appended to text
+    */
+    bool append(string &text, size_t count) {
+        static const char *const lastNames[] = {"Smith", "Tremblay", "Martin", "Roy", "Wilson", "Gagnon", "Lee", "Brown"};
+        static const char *const firstNames[] = {"Olivia", "Liam", "Emma", "Noah", "Charlotte", "William", "Amelia", "Lucas"};
+        size_t stop = made + min(count, options.employees - made);
+        text.reserve(text.size() + (stop - made) * AVERAGE_RECORD_BYTES);
+        for (; made < stop; made++) {
+            const PositionDescriptor &position = POSITIONS[cycle[made % cycle.size()]];
+            long long payRate = draw(PayInfo::minimumWage.getCents(), Employee::maximumCompanyWage.getCents());
+            long long hours = draw(0, HOURLY_HOURS_LIMIT.getHundredths());
+            long long sales = draw(0, 200000);
+            size_t sinEmployee = made;
+            if (chance(invalidChance)) {
+                // pick one of the values this position can have wrong
+                long long kinds = 1 + (position.payPolicy == HOURLY_BASED ? 1 : 0) + (position.hasSales ? 1 : 0);
+                long long kind = draw(0, kinds - 1);
+                if (kind == 0) {
+                    payRate = draw(0, PayInfo::minimumWage.getCents() - 1);
+                } else if ((kind == 1) && (position.payPolicy == HOURLY_BASED)) {
+                    hours = draw(HOURLY_HOURS_LIMIT.getHundredths() + 1, HOURLY_HOURS_LIMIT.getHundredths() * 2);
+                } else {
+                    sales = -draw(1, 5000);
+                }
+            }
+            if ((made > 0) && chance(duplicateChance)) {
+                sinEmployee = (size_t)draw(0, (long long)made - 1);
+            }
+
+            text += position.title;
+            text += '\n';
+            text += lastNames[draw(0, 7)];
+            text += '\n';
+            text += firstNames[draw(0, 7)];
+            text += '\n';
+            appendInteger(text, (long long)((sinEmployee * SIN_MULTIPLIER + sinOffset) % SIN_COUNT), 9);
+            text += '\n';
+            text += MONTH_NAMES[draw(1, 12)];
+            text += '\n';
+            appendInteger(text, draw(1, 28));
+            text += '\n';
+            appendInteger(text, draw(1950, 2005));
+            text += '\n';
+            appendHundredths(text, payRate);
+            text += '\n';
+            appendHundredths(text, hours);
+            text += '\n';
+            // sales are read in as whole dollars
+            if (position.hasSales) {
+                appendInteger(text, sales);
+                text += '\n';
+            }
+        }
+        if (made < options.employees) {
+            return true;
+        }
+        text += "END\n";
+        return false;
+    }
+
+private:
+    /* 
+    * Purpose: To pick a random whole number
+    * Parameters: low - the smallest number that can be picked
+    *             high - the largest number that can be picked
+    * Returns: the number
+    * Side Effects: the generator moves on
+    */
+    long long draw(long long low, long long high) {
+        return low + (long long)(generator() % (unsigned long long)(high - low + 1));
+    }
+
+    /* 
+    * Purpose: To decide whether something with a given chance happens
+    * Parameters: odds - the chance out of 2^32
+    * Returns: true if it happens
+    * Side Effects: the generator moves on if the chance is not 0
+    */
+    bool chance(unsigned long long odds) {
+        return (odds > 0) && (generator() < odds);
+    }
+}; // Class SyntheticRoster
+
+/* 
+* Purpose: To write a synthetic roster to a file
+* Parameters: options - what the roster should contain
+*             filename - the file to write
+* Returns: true if the file was written, false if it could not be
+* Side Effects: the file is created or replaced
+*/
+bool writeSyntheticRoster(const SyntheticRosterOptions &options, const string &filename) {
+    ofstream file(filename, ios::binary);
+    SyntheticRoster roster(options);
+    string text;
+    bool more = true;
+    // the roster is made a piece at a time so any size can be written
+    while (more && file) {
+        text.clear();
+        more = roster.append(text, STREAM_BATCH_SIZE);
+        file.write(text.data(), text.size());
+    }
+    return (bool)file.flush();
+}
+
+// Everything from here down to runBenchmark is used only by --bench. It times the stages of the
+// payroll on synthetic rosters and compares ingest against the Baseline classes, which rebuild the
+// constructor chain of the employee classes as they were before their text became views into the roster
+
+// the smallest roster the benchmark is run with, each roster after it is ten times larger
+const size_t SMALLEST_BENCHMARK_ROSTER = 1000;
+
+/* 
+* Class: NullBuffer
+* Purpose: A stream buffer that throws away everything written to it, so reports can be
+           timed without the time taken to write them anywhere
+*/
+class NullBuffer : public streambuf {
+protected:
+    virtual int overflow(int character) {return character;}
+    virtual streamsize xsputn(const char *, streamsize count) {return count;}
+}; // Class NullBuffer
+
+/* 
+* Class: BaselineText
+* Purpose: A string that counts every time its text is copied. It stands in for the std::string
+           fields of the original employee classes in the baseline ingest of the benchmark
+*/
+class BaselineText {
+private:
+    string text;
+
+public:
+    // number of times any BaselineText has been made from text or copied
+    static size_t copies;
+
+    // constructors and assignment, every one but the default constructor copies the text
+    BaselineText() {}
+    BaselineText(string_view text) : text(text) {copies++;}
+    BaselineText(const BaselineText &other) : text(other.text) {copies++;}
+    BaselineText &operator=(const BaselineText &other) {
+        text = other.text;
+        copies++;
+        return *this;
+    }
+}; // Class BaselineText
+size_t BaselineText::copies = 0;
+
+/* 
+* Class: BaselineName
+* Purpose: The Name class as it was, holding its own copy of the first and last name
+*/
+class BaselineName {
+private:
+    BaselineText firstName;
+    BaselineText lastName;
+
+public:
+    /* 
+    * Purpose: To construct a BaselineName the way Name used to be constructed
+    * Parameters: firstName, lastName - the name, taken by value
+    * Returns: Not Applicable
+    * Side Effects: each name is copied into the parameter and again into the member
+    */
+    BaselineName(BaselineText firstName, BaselineText lastName) {
+        this->firstName = firstName;
+        this->lastName = lastName;
+    }
+}; // Class BaselineName
+
+/* 
+* Class: BaselineDate
+* Purpose: The Date class as it was, holding its own copy of the month
+*/
+class BaselineDate {
+private:
+    BaselineText month;
+    int day = 0;
+    int year = 0;
+
+public:
+    /* 
+    * Purpose: To construct a BaselineDate the way Date used to be constructed
+    * Parameters: month, day, year - the date, the month taken by value
+    * Returns: Not Applicable
+    * Side Effects: the month is copied once more by setDate
+    */
+    BaselineDate(BaselineText month, int day, int year) {
+        setDate(month, day, year);
+    }
+
+    /* 
+    * Purpose: To set the date the way Date used to, passing the month on by value
+    * Parameters: month, day, year - the date
+    * Returns: NONE
+    * Side Effects: the month is copied into the member
+    */
+    void setDate(BaselineText month, int day, int year) {
+        this->month = month;
+        this->day = day;
+        this->year = year;
+    }
+}; // Class BaselineDate
+
+/* 
+* Class: BaselinePersonalInfo
+* Purpose: The PersonalInfo class as it was, passing every string on to BaselineName and
+           BaselineDate by value and keeping its own copy of the SIN
+*/
+class BaselinePersonalInfo {
+private:
+    BaselineName name;
+    BaselineDate birthday;
+    BaselineText SIN;
+
+public:
+    /* 
+    * Purpose: To construct a BaselinePersonalInfo the way PersonalInfo used to be constructed
+    * Parameters: the name, birthday and SIN of the person, the text taken by value
+    * Returns: Not Applicable
+    * Side Effects: the text is copied once more for each layer it passes through
+    */
+    BaselinePersonalInfo(BaselineText firstName, BaselineText lastName, BaselineText birthMonth, int birthDay,
+                         int birthYear, BaselineText SIN) : name(firstName, lastName), birthday(birthMonth, birthDay, birthYear) {
+        this->SIN = SIN;
+    }
+}; // Class BaselinePersonalInfo
+
+/* 
+* Class: BaselineEmployee
+* Purpose: The constructor chain of the employee classes as they were before their text became
+           views into the roster: every layer takes its strings by value and assigns them in
+           its constructor body. Only construction is kept, so the benchmark can compare the
+           copies and allocations of ingest against this baseline
+*/
+class BaselineEmployee {
+private:
+    BaselineText position;
+    BaselinePersonalInfo personalInfo;
+    Money payRate;
+    Hours hoursWorked;
+
+public:
+    /* 
+    * Purpose: To construct a baseline employee the way Employee used to be constructed
+    * Parameters: the fields of the employee, as for Employee
+    * Returns: Not Applicable
+    * Side Effects: the text is copied once for each layer it passes through, counted in BaselineText::copies
+    */
+    BaselineEmployee(BaselineText position, BaselineText firstName, BaselineText lastName, BaselineText SIN,
+                     BaselineText birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
+                     personalInfo(firstName, lastName, birthMonth, birthDay, birthYear, SIN) {
+        this->position = position;
+        this->payRate = payRate;
+        this->hoursWorked = hoursWorked;
+    }
+
+    // virtual as the position layers below are destroyed through a pointer to BaselineEmployee
+    virtual ~BaselineEmployee() {}
+}; // Class BaselineEmployee
+
+/* 
+* Class: BaselinePayPolicyEmployee
+* Purpose: The pay policy layer of the original classes, such as SalaryBasedEmployee,
+           which passed every string on to Employee by value
+*/
+class BaselinePayPolicyEmployee : public BaselineEmployee {
+public:
+    /* 
+    * Purpose: To construct the pay policy layer the way it used to be constructed
+    * Parameters: the fields of the employee, as for BaselineEmployee
+    * Returns: Not Applicable
+    * Side Effects: the text is copied once more on its way to BaselineEmployee
+    */
+    BaselinePayPolicyEmployee(BaselineText position, BaselineText firstName, BaselineText lastName, BaselineText SIN,
+                              BaselineText birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
+        BaselineEmployee(position, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked) {}
+}; // Class BaselinePayPolicyEmployee
+
+/* 
+* Class: BaselinePositionEmployee
+* Purpose: The position layer of the original classes, such as Manager, which passed every
+           string on to its pay policy layer by value
+*/
+class BaselinePositionEmployee : public BaselinePayPolicyEmployee {
+public:
+    /* 
+    * Purpose: To construct the position layer the way it used to be constructed
+    * Parameters: the fields of the employee, as for BaselineEmployee
+    * Returns: Not Applicable
+    * Side Effects: the text is copied once more on its way to BaselinePayPolicyEmployee
+    */
+    BaselinePositionEmployee(BaselineText position, BaselineText firstName, BaselineText lastName, BaselineText SIN,
+                             BaselineText birthMonth, int birthDay, int birthYear, Money payRate, Hours hoursWorked) :
+        BaselinePayPolicyEmployee(position, firstName, lastName, SIN, birthMonth, birthDay, birthYear, payRate, hoursWorked) {}
+}; // Class BaselinePositionEmployee
+
+/* 
+* Purpose: To print the time, heap allocations and string copies one stage of the benchmark took
+* Parameters: employees - the number of employees in the roster
+*             mix - the name of the position mix of the roster
+*             stage - the name of the stage
+*             records - the number of employees the stage handled, the rates are per one of these
+*             seconds - the time the stage took
+*             allocations - the number of heap allocations made in the stage
+*             copies - the number of strings copied into the roster in the stage
+* Returns: NONE
+* Side Effects: a row of the benchmark table is printed to cout
+*/
+void printBenchmarkRow(size_t employees, const char *mix, const string &stage, size_t records, double seconds,
+                       size_t allocations, size_t copies) {
+    cout << setw(10) << employees << "  " << left << setw(10) << mix << setw(32) << stage << right
+         << setw(10) << records << fixed << setprecision(4) << setw(10) << seconds
+         << setprecision(0) << setw(14) << (seconds > 0 ? records / seconds : 0.0)
+         << setprecision(1) << setw(12) << seconds * 1e9 / records
+         << setprecision(3) << setw(15) << (double)allocations / records
+         << setw(15) << (double)copies / records << endl;
+}
+
+/* 
+* Purpose: To time each stage of the payroll separately, for rosters of 1000 employees up to
+*          maxEmployees, growing ten times each step, and for every position mix. The stages are
+*          reading in the employees (and, to compare against, reading them in through the baseline
+*          constructor chain), calculating the weekly pay of the employees of each position and
+*          printing each report section.
+*          Rosters are made in memory and the reports are thrown away, so only the payroll is timed
+* Parameters: maxEmployees - the number of employees in the largest roster
+*             threads - the number of threads used to print the reports, 0 to use every core
+* Returns: the exit status of the program, 0
+* Side Effects: the benchmark table is printed to cout
+*/
+int runBenchmark(size_t maxEmployees, unsigned threads) {
+    typedef chrono::steady_clock Clock;
+    NullBuffer nullBuffer;
+    ostream nullStream(&nullBuffer);
+    static const char *const sectionNames[] = {"pay report", "employee report", "cheques"};
+
+    cout << setw(10) << "employees" << "  " << left << setw(10) << "mix" << setw(32) << "stage" << right
+         << setw(10) << "records" << setw(10) << "seconds" << setw(14) << "records/s" << setw(12) << "ns/record"
+         << setw(15) << "allocs/record" << setw(15) << "copies/record" << endl;
+    for (size_t employees = SMALLEST_BENCHMARK_ROSTER; employees <= maxEmployees; employees *= 10) {
+        for (size_t m = 0; m < NUM_POSITION_MIXES; m++) {
+            SyntheticRosterOptions synthetic;
+            synthetic.employees = employees;
+            synthetic.mix = POSITION_MIXES[m];
+            synthetic.seed = (unsigned)(employees + m);
+            string text;
+            SyntheticRoster(synthetic).append(text, employees);
+            const PositionMix &mix = synthetic.mix;
+
+            // reading in the employees, as main does
+            size_t allocations = heapAllocations.load();
+            Clock::time_point start = Clock::now();
+            Roster roster(Roster::estimateSize(text.size()));
+            RosterParser parser(text);
+            EmployeeRecord record;
+            while (parser.next(record)) {
+                createEmployee(roster, record);
+            }
+            printBenchmarkRow(employees, mix.name, "ingest", employees, chrono::duration<double>(Clock::now() - start).count(),
+                              heapAllocations.load() - allocations, roster.getCopiedStrings());
+
+            // reading in the same employees through the baseline constructor chain, to compare against
+            allocations = heapAllocations.load();
+            size_t baselineCopies = BaselineText::copies;
+            start = Clock::now();
+            vector<BaselineEmployee *> baseline;
+            baseline.reserve(Roster::estimateSize(text.size()));
+            RosterParser baselineParser(text);
+            while (baselineParser.next(record)) {
+                baseline.push_back(new BaselinePositionEmployee(record.position, record.firstName, record.lastName, record.SIN,
+                                                                record.birthMonth, record.birthDay, record.birthYear,
+                                                                record.payRate, record.hoursWorked));
+            }
+            printBenchmarkRow(employees, mix.name, "ingest (baseline)", employees, chrono::duration<double>(Clock::now() - start).count(),
+                              heapAllocations.load() - allocations, BaselineText::copies - baselineCopies);
+            for (size_t i = 0; i < baseline.size(); i++) {
+                delete baseline[i];
+            }
+
+            // calculating the weekly pay again, timed separately for the employees of each position.
+            // calcWeeklyPay is called directly so no setter or check is timed with it
+            vector<vector<Employee *>> byPosition(NUM_POSITIONS);
+            for (size_t i = 0; i < roster.size(); i++) {
+                byPosition[findPosition(roster[i]->getPosition())->tag].push_back(roster[i]);
+            }
+            for (int p = 0; p < NUM_POSITIONS; p++) {
+                if (byPosition[p].empty()) {
+                    continue;
+                }
+                allocations = heapAllocations.load();
+                start = Clock::now();
+                for (size_t i = 0; i < byPosition[p].size(); i++) {
+                    byPosition[p][i]->recalculateWeeklyPay();
+                }
+                printBenchmarkRow(employees, mix.name, string("weekly pay: ") + POSITIONS[p].title, byPosition[p].size(),
+                                  chrono::duration<double>(Clock::now() - start).count(), heapAllocations.load() - allocations, 0);
+            }
+
+            for (int section = PAY_REPORT; section <= CHEQUES; section++) {
+                ReportWriter report(nullStream);
+                allocations = heapAllocations.load();
+                start = Clock::now();
+                printReportSection(report, roster, (ReportSection)section, threads);
+                report.flush();
+                printBenchmarkRow(employees, mix.name, sectionNames[section], employees,
+                                  chrono::duration<double>(Clock::now() - start).count(),
+                                  heapAllocations.load() - allocations, 0);
+            }
+        }
+    }
+    return 0;
+}
+
+/* 
+* Purpose: To read, calculate and print the payroll of a company with every employee kept in memory.
+*          The reports are printed once every employee has been read and checked, followed by the
+*          company summary
+* Parameters: parser - the source of the employee records, such as a parser reading the employee data file
+*             expectedEmployees - the number of employees the source is expected to hold
+*             options - the options for the run
+*             out - the stream to print the reports to
+*             errorsJson - the stream validation issues are printed to as JSON, nullptr to print error messages
+*             stats - the statistics the time of each stage is added to and printed from, nullptr for none
+*             totals - set to the number of employees and total weekly pay of the company, nullptr if not needed
+* Returns: the exit status of the program, 0 on success and 99 if an unknown position was read
+*          or a timesheet delta could not be opened
+* Side Effects: the reports are printed to out
+*/
+int runPayroll(EmployeeRecordSource &parser, size_t expectedEmployees, const PayrollOptions &options, ostream &out,
+               ostream *errorsJson, RunStats *stats, CompanyTotals *totals) {
+    // the fields of each employee as they are read in
+    EmployeeRecord record;
+
+    // create the roster with room for the number of employees the file is expected to hold
+    Roster employees(expectedEmployees);
+
+    // heap allocations made before reading in the employees
+    size_t allocationsBeforeIngest = heapAllocations.load();
+
+    // validation errors found and bytes of timesheet delta read, added to the statistics at the end
+    size_t validationErrors = 0;
+    size_t deltaBytes = 0;
+
+    // process the data file to read in an employee's information, and create
+    // the appropriate employees to store within our roster.
+    StageTimer timer(stats);
+    while ( parser.next(record) ) {
+        timer.lap(PARSE_STAGE);
+        Employee *employee = createEmployee(employees, record);
+        if ( employee == nullptr ) {
+            printValidationIssues(employees, 0, out, errorsJson);
+            out << "(U): Unknown employee position '" << record.position << "'... aborting." << endl;
+            return 99;
+        }
+        timer.lapConstruction(employee);
+    }
+    // print the values that failed a check while the employees were read in
+    validationErrors += printValidationIssues(employees, 0, out, errorsJson);
+    // number of employees read in from the file
+    size_t numEmployees = employees.size();
+
+    if (options.allocationStats) {
+        printAllocationStats(heapAllocations.load() - allocationsBeforeIngest, numEmployees);
+    }
+
+    timer.lap(OUTPUT_STAGE, 0);
+
+    // report any staffing limits the roster breaks, the employees are still processed
+    if (options.enforceLimits) {
+        printPolicyViolations(out, RosterPolicy::companyDefault().check(employees));
+    }
+
+    // report any employees sharing a SIN with an earlier employee, they are still processed
+    if (options.checkSINs) {
+        SinIndex sinIndex;
+        sinIndex.build(employees, options.threads);
+        vector<string> duplicateSINs;
+        for (size_t i = 0; i < numEmployees; i++) {
+            const PersonalInfo *info = employees[i]->getPersonalInfo();
+            size_t first = sinIndex.find(info->getPackedSIN());
+            if ((first != SinIndex::NOT_FOUND) && (first != i)) {
+                duplicateSINs.push_back(describeDuplicateSIN(i, first, info->getSIN()));
+            }
+        }
+        printDuplicateSINs(out, duplicateSINs);
+    }
+    if (options.enforceLimits || options.checkSINs) {
+        timer.lap(CHECK_STAGE, numEmployees);
+    }
+
+    // in batch mode the pay periods are run instead of printing the reports for the data file
+    if (!options.periodFiles.empty()) {
+        return runPayPeriods(employees, options, out, errorsJson, timer, stats, validationErrors);
+    }
+
+    // apply this week's timesheet delta to the employees named in it
+    if (!options.deltaFile.empty()) {
+        MappedFile deltaFile;
+        if (!deltaFile.open(options.deltaFile)) {
+            out << "(U): Unable to open '" << options.deltaFile << "'... aborting." << endl;
+            return 99;
+        }
+        SinIndex sinIndex;
+        sinIndex.build(employees, options.threads);
+        vector<string> problems;
+        size_t applied = applyTimesheetDelta(employees, sinIndex, deltaFile.getContents(), problems);
+        validationErrors += printValidationIssues(employees, 0, out, errorsJson);
+        printDeltaProblems(out, problems);
+        deltaBytes = deltaFile.getSize();
+        timer.lap(DELTA_STAGE, applied);
+    }
+
+    // calculate the weekly pay of every employee again with the payroll engine, on every thread given.
+    // Its total must match the total the roster kept up to date as the employees were created, it is
+    // taken before the employees are reset
+    PayrollEngine payroll;
+    payroll.load(employees);
+    payroll.compute(options.threads);
+    Money totalWeeklyPay = payroll.getTotalWeeklyPay();
+    if (totalWeeklyPay != employees.getLedger().getTotal()) {
+        out << "(U): The payroll engine total $" << totalWeeklyPay << " does not match the roster total $"
+            << employees.getLedger().getTotal() << "... aborting." << endl;
+        return 99;
+    }
+    timer.lap(PAYROLL_STAGE, numEmployees);
+
+    // the reports are collected in a large buffer and written to out in big pieces
+    ReportWriter report(out);
+
+    // add a line break before printing reports
+    report << '\n';
+    report << payReportHeading << '\n';
+
+    if (options.fusedMode) {
+        // visit each employee once, printing the pay information reports straight away and keeping
+        // the other two sections until they are printed after it. The employees are reset for the
+        // new week in the same visit
+        ReportWriter employeeSection;
+        ReportWriter chequeSection;
+        printFusedReportSections(report, employeeSection, chequeSection, employees, options.threads);
+        timer.lap(FUSED_REPORTS_STAGE, numEmployees);
+        report << employeeReportHeading << '\n';
+        report << employeeSection.getText();
+        report << chequesHeading << '\n';
+        report << chequeSection.getText();
+        timer.lap(OUTPUT_STAGE, 0);
+    } else {
+        // print pay information report for each employee
+        printReportSection(report, employees, PAY_REPORT, options.threads);
+        timer.lap(PAY_REPORT_STAGE, numEmployees);
+
+        report << employeeReportHeading << '\n'; 
+        // print employee information report for each employee
+        printReportSection(report, employees, EMPLOYEE_REPORT, options.threads);
+        timer.lap(EMPLOYEE_REPORT_STAGE, numEmployees);
+
+        report << chequesHeading << '\n';
+        // print a cheque for each employee who earned one
+        printReportSection(report, employees, CHEQUES, options.threads);
+        timer.lap(CHEQUES_STAGE, numEmployees);
+
+        // start of a new week
+        for ( size_t i = 0; i < numEmployees; i++ ) {
+            employees[i]->reset();
+        }
+        timer.lap(RESET_STAGE, numEmployees);
+    }
+
+    printCompanySummary(report, numEmployees, totalWeeklyPay);
+    report.flush();
+    timer.lap(SUMMARY_STAGE, 0);
+
+    if (totals != nullptr) {
+        totals->employees = numEmployees;
+        totals->weeklyPay = totalWeeklyPay;
+    }
+    // the statistics go to cerr so the reports printed to out are not changed
+    if (stats != nullptr) {
+        stats->validationErrors += validationErrors;
+        stats->bytesRead += deltaBytes;
+        stats->bytesWritten = report.getBytesWritten();
+        stats->print(cerr, numEmployees);
+    }
+
+    return 0;
+}
+
+/* 
+* Purpose: To open an employee data file, or a roster snapshot, and run the payroll of the company in it
+* Parameters: filename - the name of the data file
+*             options - the options for the run
+*             out - the stream to print the reports to
+*             errorsJson - the stream validation issues are printed to as JSON, nullptr to print error messages
+*             totals - set to the number of employees and total weekly pay of the company, nullptr if not needed
+* Returns: the exit status of the program, 0 on success and 99 if the payroll could not be run
+* Side Effects: the reports are printed to out
+*/
+int runCompanyFile(const string &filename, const PayrollOptions &options, ostream &out, ostream *errorsJson,
+                   CompanyTotals *totals) {
+    MappedFile inputFile; // the contents of the data file
+    RosterSnapshot snapshot; // used when the data file is a roster snapshot
+
+    // open the file for reading, a file that cannot be opened reads as empty
+    inputFile.open( filename );
+    RosterParser textParser(inputFile.getContents());
+    EmployeeRecordSource *parser = &textParser;
+    size_t expectedEmployees = Roster::estimateSize(inputFile.getSize());
+
+    // a roster snapshot is read straight from the mapped file instead of being parsed
+    if (RosterSnapshot::isSnapshot(inputFile.getContents())) {
+        string error;
+        if (!snapshot.open(inputFile.getContents(), error)) {
+            out << "(U): Snapshot '" << filename << "' " << error << "... aborting." << endl;
+            return 99;
+        }
+        parser = &snapshot;
+        expectedEmployees = snapshot.size();
+    }
+
+    // the time and records of each stage, only kept with --stats
+    RunStats runStats;
+    RunStats *stats = options.stats ? &runStats : nullptr;
+    runStats.bytesRead = inputFile.getSize();
+
+    // in streaming mode the employees are never all kept in memory
+    if (options.streamMode) {
+        if (!options.deltaFile.empty() || !options.periodFiles.empty()) {
+            out << "(U): A timesheet delta needs the whole roster in memory and cannot be used with --stream... aborting." << endl;
+            return 99;
+        }
+        return streamPayroll(*parser, options, out, errorsJson, stats, totals);
+    }
+
+    return runPayroll(*parser, expectedEmployees, options, out, errorsJson, stats, totals);
+}
+
+/* 
+* Purpose: To find the roster files to run. A directory stands for every file in it, in name order,
+*          except the .out files reports are written to
+* Parameters: paths - the files and directories given on the command line
+* Returns: the roster files
+* Side Effects: NONE
+*/
+vector<string> findCompanyFiles(const vector<string> &paths) {
+    vector<string> files;
+    for (size_t p = 0; p < paths.size(); p++) {
+        error_code error;
+        if (!filesystem::is_directory(paths[p], error)) {
+            files.push_back(paths[p]);
+            continue;
+        }
+        vector<string> directoryFiles;
+        for (const filesystem::directory_entry &entry : filesystem::directory_iterator(paths[p], error)) {
+            if (entry.is_regular_file(error) && (entry.path().extension() != COMPANY_OUTPUT_EXTENSION)) {
+                directoryFiles.push_back(entry.path().string());
+            }
+        }
+        sort(directoryFiles.begin(), directoryFiles.end());
+        files.insert(files.end(), directoryFiles.begin(), directoryFiles.end());
+    }
+    return files;
+}
+
+/* 
+* Purpose: To run the payroll of many companies at once without prompting for a file. Each roster
+*          file is run on its own by a pool of threads, with nothing shared between them, and its
+*          reports are written to the file's name followed by .out, in outputDirectory if one is given.
+*          Once every company has run a line for each of them and a combined summary are printed
+* Parameters: paths - the roster files, and directories of roster files, to run
+*             options - the options for every run, threads is the number of companies run at once
+*             outputDirectory - the directory the reports are written to, empty to write them beside each roster file
+* Returns: the exit status of the program, 0 if every company ran and 99 if any did not
+* Side Effects: a report file is written for each company and the combined summary is printed to cout
+*/
+int runCompanies(const vector<string> &paths, const PayrollOptions &options, const string &outputDirectory) {
+    vector<string> files = findCompanyFiles(paths);
+    if (files.empty()) {
+        cout << "(U): No roster files were found... aborting." << endl;
+        return 99;
+    }
+    vector<string> outputs(files.size());
+    for (size_t f = 0; f < files.size(); f++) {
+        filesystem::path output = outputDirectory.empty() ? filesystem::path(files[f])
+                                                          : filesystem::path(outputDirectory) / filesystem::path(files[f]).filename();
+        outputs[f] = output.string() + COMPANY_OUTPUT_EXTENSION;
+    }
+
+    // the companies are run side by side, so each one prints its reports on a single thread
+    PayrollOptions companyOptions = options;
+    companyOptions.threads = 1;
+
+    // each thread takes the next company nobody has started until there are none left
+    vector<CompanyTotals> totals(files.size());
+    vector<int> statuses(files.size(), 0);
+    runOnThreads(options.threads, files.size(), [&](size_t f) {
+        error_code error;
+        if (!filesystem::is_regular_file(files[f], error)) {
+            statuses[f] = COMPANY_MISSING;
+            return;
+        }
+        ofstream out(outputs[f]);
+        if (!out) {
+            statuses[f] = COMPANY_UNWRITABLE;
+            return;
+        }
+        statuses[f] = runCompanyFile(files[f], companyOptions, out, nullptr, &totals[f]);
+    });
+
+    // print how each company went in the order they were given, then the totals of the companies that ran
+    CompanyTotals combined;
+    size_t companies = 0;
+    for (size_t f = 0; f < files.size(); f++) {
+        if (statuses[f] == 0) {
+            cout << files[f] << ": " << totals[f].employees << " employees, Total Weekly Pay: $" << totals[f].weeklyPay
+                 << " (reports in " << outputs[f] << ")" << endl;
+            combined.employees += totals[f].employees;
+            combined.weeklyPay += totals[f].weeklyPay;
+            companies++;
+        } else if (statuses[f] == COMPANY_MISSING) {
+            cout << "(U): Unable to open '" << files[f] << "', it was not run." << endl;
+        } else if (statuses[f] == COMPANY_UNWRITABLE) {
+            cout << "(U): Unable to create '" << outputs[f] << "', " << files[f] << " was not run." << endl;
+        } else {
+            cout << "(U): " << files[f] << " could not be run, see " << outputs[f] << "." << endl;
+        }
+    }
+
+    cout << endl;
+    cout << combinedSummaryHeading << endl;
+    cout << "Number of Companies: " << companies << endl;
+    cout << "Number of Employees: " << combined.employees << endl;
+    cout << "Total Weekly Pay: $" << combined.weeklyPay << endl;
+    cout << endl;
+    // closing message
+    cout << "Thank you for using this employee HR management system!" << endl;
+    return companies == files.size() ? 0 : 99;
+}
+
+int main(int argc, char *argv[]) {
+    // variables to store the information read in from the file
+    string filename;
+    // the options set on the command line
+    PayrollOptions options;
+    // size of the largest roster to benchmark, 0 when not benchmarking
+    size_t benchmarkEmployees = 0;
+    // the synthetic roster to generate and the file to write it to, empty when not generating
+    SyntheticRosterOptions synthetic;
+    string syntheticFile;
+    // roster files and directories given on the command line, run without prompting, and where their reports go
+    vector<string> companyPaths;
+    string outputDirectory;
+
+    // read the command line options
+    for (int arg = 1; arg < argc; arg++) {
+        string option = argv[arg];
+        if (option == "--enforce-limits") {
+            options.enforceLimits = true;
+        } else if (option == "--alloc-stats") {
+            options.allocationStats = true;
+            countHeapAllocations = true;
+        } else if (option == "--check-sins") {
+            options.checkSINs = true;
+        } else if (option == "--stream") {
+            options.streamMode = true;
+        } else if (option == "--stats") {
+            options.stats = true;
+        } else if (option == "--fused") {
+            options.fusedMode = true;
+        } else if ((option == "--delta") && (arg + 1 < argc)) {
+            options.deltaFile = argv[++arg];
+        } else if ((option == "--errors-json") && (arg + 1 < argc)) {
+            options.errorsJsonFile = argv[++arg];
+        } else if ((option == "--period") && (arg + 1 < argc)) {
+            options.periodFiles.push_back(argv[++arg]);
+        } else if ((option == "--threads") && (arg + 1 < argc)) {
+            options.threads = (unsigned)atoi(argv[++arg]);
+        } else if ((option == "--compile-snapshot") && (arg + 2 < argc)) {
+            // compile a data file into a roster snapshot and exit
+            string error;
+            size_t count = 0;
+            MappedFile textFile;
+            if (!textFile.open(argv[arg + 1])) {
+                cout << "(U): Unable to open '" << argv[arg + 1] << "'... aborting." << endl;
+                return 99;
+            }
+            RosterParser textParser(textFile.getContents());
+            if (!RosterSnapshot::write(textParser, argv[arg + 2], count, error)) {
+                cout << "(U): Unable to compile snapshot, " << error << "... aborting." << endl;
+                return 99;
+            }
+            cout << "Compiled " << count << " employees into '" << argv[arg + 2] << "'." << endl;
+            return 0;
+        } else if ((option == "--bench") && (arg + 1 < argc)) {
+            // time each stage of the payroll for synthetic rosters and exit
+            size_t maxEmployees = (size_t)atoll(argv[++arg]);
+            if (maxEmployees < SMALLEST_BENCHMARK_ROSTER) {
+                cout << "(U): --bench needs a roster size of at least " << SMALLEST_BENCHMARK_ROSTER << "... aborting." << endl;
+                return 99;
+            }
+            benchmarkEmployees = maxEmployees;
+            countHeapAllocations = true;
+        } else if ((option == "--generate") && (arg + 2 < argc)) {
+            // write a synthetic roster and exit
+            synthetic.employees = (size_t)atoll(argv[arg + 1]);
+            syntheticFile = argv[arg + 2];
+            arg += 2;
+        } else if ((option == "--seed") && (arg + 1 < argc)) {
+            synthetic.seed = (unsigned)strtoul(argv[++arg], nullptr, 10);
+        } else if ((option == "--mix") && (arg + 1 < argc)) {
+            if (!parsePositionMix(argv[++arg], synthetic.mix)) {
+                cout << "(U): Unknown position mix '" << argv[arg] << "'... aborting." << endl;
+                return 99;
+            }
+        } else if (((option == "--invalid-fraction") || (option == "--duplicate-fraction")) && (arg + 1 < argc)) {
+            double fraction = atof(argv[++arg]);
+            if (!(fraction >= 0) || (fraction > 1)) {
+                cout << "(U): " << option << " must be between 0 and 1... aborting." << endl;
+                return 99;
+            }
+            (option == "--invalid-fraction" ? synthetic.invalidFraction : synthetic.duplicateFraction) = fraction;
+        } else if ((option == "--output-dir") && (arg + 1 < argc)) {
+            outputDirectory = argv[++arg];
+        } else if (option.compare(0, 2, "--") != 0) {
+            // anything that is not an option is a roster file or a directory of them
+            companyPaths.push_back(option);
+        } else if (option == "--check-kernels") {
+            // compare the vector pay kernels against the scalar ones and exit
+            size_t mismatches = HourlyPayKernel::selfCheck(100003, 2003);
+            cout << "Hourly pay kernel: " << (HourlyPayKernel::avx2Supported() ? "AVX2" : "scalar only") << ", "
+                 << mismatches << " mismatched results." << endl;
+            // compare the payroll engine against the Employee classes
+            size_t engineMismatches = PayrollEngine::selfCheck(100003, 2003, options.threads);
+            cout << "Payroll engine: " << engineMismatches << " mismatched results." << endl;
+            return (mismatches == 0) && (engineMismatches == 0) ? 0 : 1;
+        } else {
+            cout << "(U): Unknown option '" << option << "'... aborting." << endl;
+            return 99;
+        }
+    }
+
+    // the benchmark is run once every option has been read so it uses the number of threads given
+    if (benchmarkEmployees > 0) {
+        return runBenchmark(benchmarkEmployees, options.threads);
+    }
+
+    // likewise a synthetic roster is written once its seed, mix and fractions have been read
+    if (!syntheticFile.empty()) {
+        if (!writeSyntheticRoster(synthetic, syntheticFile)) {
+            cout << "(U): Unable to write '" << syntheticFile << "'... aborting." << endl;
+            return 99;
+        }
+        cout << "Generated " << synthetic.employees << " employees into '" << syntheticFile << "'." << endl;
+        return 0;
+    }
+
+    if (!options.deltaFile.empty() && !options.periodFiles.empty()) {
+        cout << "(U): --delta cannot be used with --period, give each week as a period instead... aborting." << endl;
+        return 99;
+    }
+
+    // roster files given on the command line are all run without prompting
+    if (!companyPaths.empty()) {
+        if (!options.deltaFile.empty() || !options.periodFiles.empty() || !options.errorsJsonFile.empty()
+            || options.stats || options.allocationStats) {
+            cout << "(U): --delta, --period, --errors-json, --stats and --alloc-stats work on a single roster"
+                 << " and cannot be used with roster files on the command line... aborting." << endl;
+            return 99;
+        }
+        return runCompanies(companyPaths, options, outputDirectory);
+    }
+
+    // validation issues are written to a JSON file instead of being printed when one is given
+    ofstream errorsJsonFile;
+    ostream *errorsJson = nullptr;
+    if (!options.errorsJsonFile.empty()) {
+        errorsJsonFile.open(options.errorsJsonFile);
+        if (!errorsJsonFile) {
+            cout << "(U): Unable to create '" << options.errorsJsonFile << "'... aborting." << endl;
+            return 99;
+        }
+        errorsJson = &errorsJsonFile;
+    }
+
+    // welcome message
+    cout << "Welcome to Daniel's employee HR management system!" << endl;
+
+    // get the name of the data file
+    cout << "Please enter the name of the data file: ";
+    getline( cin, filename );
+
+    return runCompanyFile(filename, options, cout, errorsJson, nullptr);
 }
@@ -0,0 +1,40 @@
+#!/bin/sh
+# Builds the program and runs its checks. Exits with a non-zero status as soon as one fails.
+# Usage (from anywhere): EmployeeCPP/tests/run_tests.sh
+set -e
+cd "$(dirname "$0")/.."
+work=$(mktemp -d "${TMPDIR:-/tmp}/employee-tests.XXXXXX")
+trap 'rm -rf "$work"' EXIT
+
+g++ -std=c++17 -O2 -pthread -o "$work/employee" employee.cpp
+
+# the vectorized pay kernels and the payroll engine must match the scalar code and the employee classes
+"$work/employee" --check-kernels
+
+# compare the reports of one run against the expected reports of the example data file
+# usage: check <data file> <expected reports> <description> [options...]
+check() {
+    check_input=$1
+    check_expected=$2
+    check_description=$3
+    shift 3
+    echo "$check_input" | "$work/employee" "$@" > "$work/actual.out"
+    if ! cmp -s "$check_expected" "$work/actual.out"; then
+        echo "$check_description: the reports do not match $check_expected"
+        diff "$check_expected" "$work/actual.out" | head -20
+        exit 1
+    fi
+}
+
+# every example data file must give its expected reports on one thread, on every core, streamed,
+# fused and when it is first compiled into a snapshot
+for input in tests/*.in; do
+    expected="${input%.in}.out"
+    check "$input" "$expected" "$input"
+    check "$input" "$expected" "$input --threads 1" --threads 1
+    check "$input" "$expected" "$input --stream" --stream
+    check "$input" "$expected" "$input --fused" --fused
+    "$work/employee" --compile-snapshot "$input" "$work/roster.snap" > /dev/null
+    check "$work/roster.snap" "$expected" "$input as a snapshot"
+    echo "$input: OK"
+done